@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/dynamic_csr.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /** Random edges, four per node */
+    auto make_edges(uint32_t num_nodes, std::vector<uint32_t> &from, std::vector<uint32_t> &to) {
+        auto gen = std::mt19937(42);
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        for (uint32_t i = 0; i != 4 * num_nodes; ++i) {
+            from.push_back(node(gen));
+            to.push_back(node(gen));
+        }
+    }
+
+    /** One edge added and a random one removed per iteration */
+    void BM_dynamic_update(benchmark::State &state) {
+        const auto num_nodes = uint32_t(state.range(0));
+        auto from = std::vector<uint32_t>{};
+        auto to = std::vector<uint32_t>{};
+        make_edges(num_nodes, from, to);
+        auto gra = DynamicCsrGraph(num_nodes, from, to);
+        auto gen = std::mt19937(7);
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        auto live = std::vector<uint32_t>(from.size());
+        for (uint32_t i = 0; i != live.size(); ++i) {
+            live[i] = i;
+        }
+        for (auto _ : state) {
+            const auto idx = gen() % live.size();
+            gra.remove_edge(live[idx]);
+            live[idx] = gra.add_edge(node(gen), node(gen));
+        }
+        state.counters["rebalances"] = double(gra.rebalances());
+    }
+
+    /** The same update by rebuilding a `CsrGraph` */
+    void BM_csr_rebuild(benchmark::State &state) {
+        const auto num_nodes = uint32_t(state.range(0));
+        auto from = std::vector<uint32_t>{};
+        auto to = std::vector<uint32_t>{};
+        make_edges(num_nodes, from, to);
+        auto gra = CsrGraph(num_nodes, from, to);
+        auto gen = std::mt19937(7);
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        for (auto _ : state) {
+            const auto idx = gen() % from.size();
+            from[idx] = node(gen);
+            to[idx] = node(gen);
+            gra.assign(num_nodes, from, to);
+        }
+    }
+
+    /** A sweep over all edges, as one relaxation pass takes */
+    template <typename Graph> void BM_sweep(benchmark::State &state) {
+        const auto num_nodes = uint32_t(state.range(0));
+        auto from = std::vector<uint32_t>{};
+        auto to = std::vector<uint32_t>{};
+        make_edges(num_nodes, from, to);
+        const auto gra = Graph(num_nodes, from, to);
+        for (auto _ : state) {
+            auto sum = uint64_t{0};
+            for (const auto &[utx, neighbors] : gra) {
+                for (const auto &[vtx, edge] : neighbors) {
+                    sum += vtx ^ edge;
+                }
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+    }
+
+}  // namespace
+
+BENCHMARK(BM_dynamic_update)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_csr_rebuild)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_sweep<CsrGraph>)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_sweep<DynamicCsrGraph>)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/min_cost_flow.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief A transportation network: a grid of `side * side` nodes with arcs to the right
+     * and downwards plus random shortcuts, and supplies in the first row that must reach the
+     * last one
+     */
+    struct Network {
+        uint32_t num_nodes{0};
+        std::vector<uint32_t> from{};
+        std::vector<uint32_t> to{};
+        std::vector<int64_t> capacity{};
+        std::vector<int64_t> cost{};
+        std::vector<int64_t> supply{};
+    };
+
+    auto make_network(uint32_t side) -> Network {
+        auto gen = std::mt19937(42);
+        auto cap = std::uniform_int_distribution<int64_t>(1, 20);
+        auto price = std::uniform_int_distribution<int64_t>(1, 100);
+        auto node = std::uniform_int_distribution<uint32_t>(0, side * side - 1);
+
+        auto net = Network{};
+        net.num_nodes = side * side;
+        auto add_arc = [&](uint32_t utx, uint32_t vtx) {
+            net.from.push_back(utx);
+            net.to.push_back(vtx);
+            net.capacity.push_back(cap(gen));
+            net.cost.push_back(price(gen));
+        };
+        for (uint32_t row = 0; row != side; ++row) {
+            for (uint32_t col = 0; col != side; ++col) {
+                const auto utx = row * side + col;
+                if (col + 1 != side) {
+                    add_arc(utx, utx + 1);
+                    add_arc(utx + 1, utx);
+                }
+                if (row + 1 != side) {
+                    add_arc(utx, utx + side);
+                }
+                add_arc(utx, node(gen));
+            }
+        }
+        net.supply.assign(net.num_nodes, 0);
+        for (uint32_t col = 0; col != side; ++col) {
+            net.supply[col] = 2;
+            net.supply[(side - 1) * side + col] = -2;
+        }
+        return net;
+    }
+
+    void BM_min_mean_cycle_canceling(benchmark::State &state) {
+        const auto net = make_network(uint32_t(state.range(0)));
+        auto mcf = digraphx::MinCostFlow(net.num_nodes, net.from, net.to, net.capacity, net.cost);
+        // every solve after the first is warm started by the potentials of the one before
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(mcf.solve(net.supply));
+        }
+        state.counters["arcs"] = double(net.from.size());
+    }
+
+    void BM_cost_scaling(benchmark::State &state) {
+        const auto net = make_network(uint32_t(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(digraphx::min_cost_flow_cost_scaling(
+                net.num_nodes, net.from, net.to, net.capacity, net.cost, net.supply));
+        }
+        state.counters["arcs"] = double(net.from.size());
+    }
+
+}  // namespace
+
+BENCHMARK(BM_min_mean_cycle_canceling)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_cost_scaling)->Arg(4)->Arg(8)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
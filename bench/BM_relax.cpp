@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <digraphx/relaxer.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief A graph without negative cycles whose in-degrees are skewed: every node also has
+     * an edge to one of a few hub nodes
+     *
+     * The other edges go to random nodes, or to the next `reach` nodes if `reach` is not 0,
+     * which gives the locality of a mesh numbered along its rows. Node heights spread over
+     * `10 * spread` make the weights negative; below 1 few of them are, as in the later
+     * iterations of a parametric search.
+     */
+    struct SkewedGraph {
+        CsrGraph csr{};
+        std::vector<double> weight{};
+    };
+
+    auto make_skewed_graph(uint32_t num_nodes, uint32_t reach, double spread) -> SkewedGraph {
+        auto gen = std::mt19937(42);
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        auto near = std::uniform_int_distribution<uint32_t>(0, reach - 1);
+        auto slack = std::uniform_real_distribution<double>(0.0, 10.0);
+        auto height = std::vector<double>(num_nodes);
+        for (auto &h : height) {
+            h = slack(gen) * spread;
+        }
+        auto from = std::vector<uint32_t>{};
+        auto to = std::vector<uint32_t>{};
+        auto gra = SkewedGraph{};
+        auto add_edge = [&](uint32_t utx, uint32_t vtx) {
+            from.push_back(utx);
+            to.push_back(vtx);
+            gra.weight.push_back(slack(gen) + height[vtx] - height[utx]);
+        };
+        for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+            for (auto i = 0; i != 4; ++i) {
+                add_edge(utx, reach == 0 ? node(gen) : (utx + near(gen)) % num_nodes);
+            }
+            add_edge(utx, node(gen) % 16);
+        }
+        gra.csr.assign(num_nodes, from, to);
+        return gra;
+    }
+
+    void run_howard(benchmark::State &state, const digraphx::RelaxOptions &options,
+                    uint32_t reach = 0, double spread = 100.0) {
+        const auto gra = make_skewed_graph(uint32_t(state.range(0)), reach, spread);
+        auto dist = std::vector<double>(gra.csr.num_nodes());
+        for (auto _ : state) {
+            std::fill(dist.begin(), dist.end(), 0.0);
+            auto ncf = NegCycleFinder<CsrGraph>(gra.csr);
+            ncf.set_relax_options(options);
+            for (const auto &cycle : ncf.howard(dist, EdgeWeights<double>(gra.weight))) {
+                benchmark::DoNotOptimize(cycle);
+            }
+            state.counters["passes"] = double(ncf.passes());
+        }
+    }
+
+    void BM_relax_sweep(benchmark::State &state) { run_howard(state, {}); }
+
+    void BM_relax_push_pull(benchmark::State &state) {
+        run_howard(state, {digraphx::RelaxMode::PushPull, size_t(state.range(1)), 0.05});
+    }
+
+    void BM_relax_async(benchmark::State &state) {
+        auto options = digraphx::RelaxOptions{};
+        options.mode = digraphx::RelaxMode::Async;
+        options.threads = size_t(state.range(1));
+        run_howard(state, options);
+    }
+
+    void BM_relax_delta(benchmark::State &state) {
+        auto options = digraphx::RelaxOptions{};
+        options.mode = digraphx::RelaxMode::Delta;
+        options.threads = size_t(state.range(1));
+        run_howard(state, options);
+    }
+
+    void BM_relax_sweep_mostly_positive(benchmark::State &state) {
+        run_howard(state, {}, 0, 0.1);
+    }
+
+    void BM_relax_delta_mostly_positive(benchmark::State &state) {
+        auto options = digraphx::RelaxOptions{};
+        options.mode = digraphx::RelaxMode::Delta;
+        options.threads = size_t(state.range(1));
+        run_howard(state, options, 0, 0.1);
+    }
+
+    /** A sequential mode on the random, local or mostly positive graph */
+    void BM_relax_queue(benchmark::State &state, digraphx::RelaxMode mode, uint32_t reach,
+                        double spread) {
+        auto options = digraphx::RelaxOptions{};
+        options.mode = mode;
+        run_howard(state, options, reach, spread);
+    }
+
+    void BM_relax_sweep_local(benchmark::State &state) { run_howard(state, {}, 4096); }
+
+    void BM_relax_blocked_local(benchmark::State &state) {
+        auto options = digraphx::RelaxOptions{};
+        options.mode = digraphx::RelaxMode::Blocked;
+        run_howard(state, options, 4096);
+    }
+
+}  // namespace
+
+BENCHMARK(BM_relax_sweep)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_relax_push_pull)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_relax_async)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_relax_delta)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_relax_sweep_mostly_positive)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_relax_delta_mostly_positive)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_relax_sweep_local)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_relax_blocked_local)->Arg(1 << 20)->Arg(1 << 23)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, deque, digraphx::RelaxMode::Deque, 0, 100.0)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, threshold, digraphx::RelaxMode::Threshold, 0, 100.0)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, deque_local, digraphx::RelaxMode::Deque, 4096, 100.0)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, threshold_local, digraphx::RelaxMode::Threshold, 4096, 100.0)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, deque_mostly_positive, digraphx::RelaxMode::Deque, 0, 0.1)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, threshold_mostly_positive, digraphx::RelaxMode::Threshold, 0,
+                  0.1)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, adaptive, digraphx::RelaxMode::Adaptive, 0, 100.0)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, adaptive_local, digraphx::RelaxMode::Adaptive, 4096, 100.0)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_relax_queue, adaptive_mostly_positive, digraphx::RelaxMode::Adaptive, 0,
+                  0.1)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>  // for swap
+#include <cstdint>    // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/relaxer.hpp>
+#include <digraphx/scc.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief A graph with one giant component, a few thousand small ones and
+     * acyclic fringes: 3/4 of the nodes on a ring with random chords, the
+     * rest in rings of 4 and tails of single nodes, linked by edges that only
+     * go forward in node order
+     */
+    auto make_scc_graph(uint32_t num_nodes) -> CsrGraph {
+        auto gen = std::mt19937(42);
+        const auto giant = num_nodes / 4 * 3;
+        auto from = std::vector<uint32_t>{};
+        auto to = std::vector<uint32_t>{};
+        auto add_edge = [&](uint32_t utx, uint32_t vtx) {
+            from.push_back(utx);
+            to.push_back(vtx);
+        };
+        auto in_giant = std::uniform_int_distribution<uint32_t>(0, giant - 1);
+        for (uint32_t utx = 0; utx != giant; ++utx) {
+            add_edge(utx, (utx + 1) % giant);
+            add_edge(utx, in_giant(gen));
+        }
+        for (auto utx = giant; utx + 4 <= num_nodes; utx += 8) {
+            for (uint32_t i = 0; i != 4; ++i) {
+                add_edge(utx + i, utx + (i + 1) % 4);
+            }
+        }
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        for (uint32_t i = 0; i != num_nodes; ++i) {
+            auto utx = node(gen);
+            auto vtx = node(gen);
+            if (utx > vtx) {
+                std::swap(utx, vtx);
+            }
+            if (vtx >= giant) {
+                add_edge(utx, vtx);
+            }
+        }
+        return CsrGraph(num_nodes, from, to);
+    }
+
+    void BM_scc(benchmark::State &state) {
+        const auto gra = make_scc_graph(uint32_t(state.range(0)));
+        const auto transpose = digraphx::CsrTranspose(gra);
+        const auto options = digraphx::SccOptions{.threads = size_t(state.range(1))};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                digraphx::strongly_connected_components(gra, transpose, options));
+        }
+    }
+
+}  // namespace
+
+BENCHMARK(BM_scc)
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 4})
+    ->Args({1 << 23, 1})
+    ->Args({1 << 23, 4})
+    ->Unit(benchmark::kMillisecond);
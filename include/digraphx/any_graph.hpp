@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <memory>   // for unique_ptr, make_unique
+#include <span>
+#include <unordered_map>
+#include <utility>  // for move
+#include <vector>
+
+#include "concepts.hpp"   // for DiGraphLike, DenseNodeGraph, graph_node_t, graph_edge_t
+#include "csr_graph.hpp"  // for CsrGraph, EdgeWeights
+#include "neg_cycle.hpp"  // for NegCycleFinder
+
+/**
+ * @file any_graph.hpp
+ * @brief Solvers for graphs and parametric APIs whose types are only known at runtime
+ *
+ * `AnyGraph<Node, Edge>` accepts any `DiGraphLike` container with the given
+ * node and edge types, and `AnyParametricAPI<Edge, Ratio>` any object with the
+ * `distance`/`zero_cancel` interface of `CycleRatioAPI`. Neither puts a
+ * virtual call in the relaxation loop: the graph is converted once to a
+ * `CsrGraph`, the API evaluates the weights of all edges in one virtual call
+ * per parameter value, and the solve itself runs `NegCycleFinder<CsrGraph>`
+ * with `EdgeWeights`, i.e. the same fully inlined (and, for the usual weight
+ * types, precompiled) code as a statically typed CSR solve.
+ */
+
+/**
+ * @brief A directed graph of any container type, held as a `CsrGraph`
+ *
+ * Nodes are numbered in the order they are first seen while iterating the
+ * source graph (their own value for a `DenseNodeGraph`), and edges in
+ * iteration order; `node()` and `edge()` map the numbers back.
+ *
+ * @tparam Node node type of the source graphs
+ * @tparam Edge edge type of the source graphs
+ */
+template <typename Node, typename Edge> class AnyGraph {
+    CsrGraph _csr{};
+    std::vector<Node> _nodes{};
+    std::vector<Edge> _edges{};
+
+  public:
+    /**
+     * @brief Construct a new Any Graph object from any digraph with matching node and edge types
+     *
+     * @param[in] gra the source graph; it is not referenced after construction
+     */
+    template <DiGraphLike DiGraph>
+        requires std::same_as<graph_node_t<DiGraph>, Node>
+                 && std::same_as<graph_edge_t<DiGraph>, Edge>
+    explicit AnyGraph(const DiGraph &gra) {
+        auto source = std::vector<uint32_t>{};
+        auto target = std::vector<uint32_t>{};
+        if constexpr (DenseNodeGraph<DiGraph>) {
+            for (size_t i = 0; i != gra.size(); ++i) {
+                this->_nodes.push_back(Node(i));
+            }
+            for (const auto &[utx, neighbors] : gra) {
+                for (const auto &[vtx, edge] : neighbors) {
+                    source.push_back(uint32_t(utx));
+                    target.push_back(uint32_t(vtx));
+                    this->_edges.push_back(edge);
+                }
+            }
+        } else {
+            auto index = std::unordered_map<Node, uint32_t>{};
+            auto index_of = [this, &index](const Node &node) -> uint32_t {
+                const auto [it, inserted] = index.try_emplace(node, uint32_t(this->_nodes.size()));
+                if (inserted) {
+                    this->_nodes.push_back(node);
+                }
+                return it->second;
+            };
+            for (const auto &[utx, neighbors] : gra) {
+                const auto from = index_of(utx);
+                for (const auto &[vtx, edge] : neighbors) {
+                    source.push_back(from);
+                    target.push_back(index_of(vtx));
+                    this->_edges.push_back(edge);
+                }
+            }
+        }
+        this->_csr.assign(this->_nodes.size(), source, target);
+    }
+
+    auto csr() const -> const CsrGraph & { return this->_csr; }
+    auto num_nodes() const -> size_t { return this->_nodes.size(); }
+    auto num_edges() const -> size_t { return this->_edges.size(); }
+
+    /** The node numbered `idx` */
+    auto node(uint32_t idx) const -> const Node & { return this->_nodes[idx]; }
+    /** The edge numbered `idx` */
+    auto edge(uint32_t idx) const -> const Edge & { return this->_edges[idx]; }
+    /** All edges, indexed by their number */
+    auto edges() const -> std::span<const Edge> { return this->_edges; }
+
+    /** The edges numbered by `ids`, e.g. a cycle found on `csr()` */
+    auto edges(std::span<const uint32_t> ids) const -> std::vector<Edge> {
+        auto result = std::vector<Edge>{};
+        result.reserve(ids.size());
+        for (const auto idx : ids) {
+            result.push_back(this->_edges[idx]);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Type-erased parametric API (see `MaxParametricSolver`)
+ *
+ * Wraps any object `api` providing `api.distance(ratio, edge)` and
+ * `api.zero_cancel(cycle)`. Distances are evaluated for a whole edge array per
+ * call, so the virtual dispatch happens once per parameter value rather than
+ * once per edge, and the loop inside calls the wrapped `distance` directly.
+ *
+ * @tparam Edge edge type
+ * @tparam Ratio parameter type
+ */
+template <typename Edge, typename Ratio> class AnyParametricAPI {
+    using Cycle = std::vector<Edge>;
+
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void distances(const Ratio &ratio, std::span<const Edge> edges,
+                               std::span<Ratio> out)
+            = 0;
+        virtual auto zero_cancel(const Cycle &cycle) -> Ratio = 0;
+    };
+
+    template <typename API> struct Model final : Concept {
+        API api;
+
+        explicit Model(API &&api) : api{std::move(api)} {}
+
+        void distances(const Ratio &ratio, std::span<const Edge> edges,
+                       std::span<Ratio> out) override {
+            auto param = ratio;  // `distance` may take the ratio by non-const reference
+            for (size_t i = 0; i != edges.size(); ++i) {
+                out[i] = Ratio(this->api.distance(param, edges[i]));
+            }
+        }
+
+        auto zero_cancel(const Cycle &cycle) -> Ratio override {
+            return Ratio(this->api.zero_cancel(cycle));
+        }
+    };
+
+    std::unique_ptr<Concept> _self;
+
+  public:
+    /**
+     * @brief Construct a new Any Parametric API object
+     *
+     * @param[in] api the wrapped API, moved into the new object
+     */
+    template <typename API> explicit AnyParametricAPI(API api)
+        : _self{std::make_unique<Model<API>>(std::move(api))} {}
+
+    /**
+     * @brief Evaluates `distance(ratio, edges[i])` into `out[i]` for every edge
+     */
+    void distances(const Ratio &ratio, std::span<const Edge> edges, std::span<Ratio> out) {
+        this->_self->distances(ratio, edges, out);
+    }
+
+    auto zero_cancel(const Cycle &cycle) -> Ratio { return this->_self->zero_cancel(cycle); }
+};
+
+/**
+ * @brief `max_parametric` on an `AnyGraph` with an `AnyParametricAPI`
+ *
+ * Solves
+ *
+ *  max  r
+ *  s.t. dist[v] - dist[u] <= distance(r, e)
+ *       \forall e(u, v) \in gra(V, E)
+ *
+ * with one virtual `distances` call per value of `r` and one `zero_cancel`
+ * call per cycle found; the relaxation runs on `gra.csr()`.
+ *
+ * @param[in] gra the graph
+ * @param[in,out] r_opt the parameter, initially large; the optimum on return
+ * @param[in] omega the API
+ * @param[in,out] dist distance of each node, indexed by the node number
+ * @return the critical cycle, as edges of the source graph
+ */
+template <typename Node, typename Edge, typename Ratio>
+auto max_parametric(const AnyGraph<Node, Edge> &gra, Ratio &r_opt,
+                    AnyParametricAPI<Edge, Ratio> &omega, std::vector<Ratio> &dist)
+    -> std::vector<Edge> {
+    using Cycle = std::vector<Edge>;
+
+    auto weight = std::vector<Ratio>(gra.num_edges());
+    auto ncf = NegCycleFinder<CsrGraph>(gra.csr());
+    auto r_min = r_opt;
+    auto c_min = Cycle{};
+    auto c_opt = Cycle{};
+
+    while (true) {
+        omega.distances(r_opt, gra.edges(), weight);
+        for (const auto &ci : ncf.howard(dist, EdgeWeights<Ratio>(weight))) {
+            auto cycle = gra.edges(ci);
+            auto ri = omega.zero_cancel(cycle);
+            if (r_min > ri) {
+                r_min = ri;
+                c_min = std::move(cycle);
+            }
+        }
+        if (r_min >= r_opt) {
+            break;
+        }
+
+        c_opt = c_min;
+        r_opt = r_min;
+    }
+
+    return c_opt;
+}
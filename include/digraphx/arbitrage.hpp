@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>  // for uint8_t, uint32_t, uint64_t
+#include <iosfwd>   // for istream
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+#include "neg_cycle.hpp"  // for NegCycleFinder
+#include "scc.hpp"        // for IncrementalScc
+
+namespace digraphx {
+
+    /** A quote: one unit of currency `from` buys `rate` units of currency `to` */
+    struct RateQuote {
+        uint32_t from{0};
+        uint32_t to{0};
+        double rate{0.0};  ///< a non-positive rate withdraws the quote
+    };
+
+    /** A quote stamped with the time it was recorded */
+    struct RateTick {
+        uint64_t time{0};
+        RateQuote quote{};
+    };
+
+    /**
+     * @brief Reads recorded ticks, one `time from to rate` line each
+     *
+     * Empty lines and lines starting with `#` are skipped.
+     *
+     * @exception std::runtime_error on a malformed line
+     */
+    auto read_rate_ticks(std::istream &input) -> std::vector<RateTick>;
+
+    /** An arbitrage opportunity */
+    struct ArbitrageCycle {
+        std::vector<uint32_t> currencies{};  ///< the currencies traded, in order
+        double profit{0.0};                  ///< product of the rates minus one
+    };
+
+    /** Outcome of `ArbitrageDetector::tick` */
+    struct ArbitrageReport {
+        std::vector<ArbitrageCycle> cycles{};
+        size_t passes{0};        ///< relaxation passes spent on this tick
+        bool converged{false};   ///< no arbitrage left and the potentials are settled
+        bool searched{false};    ///< false if no quote of the tick could close a cycle
+    };
+
+    /** Settings of an `ArbitrageDetector` */
+    struct ArbitrageOptions {
+        size_t max_passes{16};   ///< relaxation passes per tick, 0 for no limit
+        double min_profit{1e-9}; ///< smaller profits are treated as rounding noise
+    };
+
+    /**
+     * @brief Streaming arbitrage detection on `-log(rate)` weights
+     *
+     * The currency pairs form a fixed `CsrGraph` whose edge weights are
+     * `-log(rate)`, so a cycle of rates with a product above one is a negative
+     * cycle. Each tick applies a batch of quotes in O(batch) and then runs
+     * `NegCycleFinder::howard` from the potentials left by the previous tick:
+     * while the market is free of arbitrage those potentials are almost right
+     * and a few passes settle them. At most `max_passes` passes are spent per
+     * tick; a tick that runs out reports `converged == false` and the next one
+     * carries on from where it stopped, so the latency of a tick stays bounded
+     * at the price of reporting a cycle a tick or two later. Potentials are
+     * reset after an arbitrage is reported, since the negative cycle drives
+     * them down without bound.
+     *
+     * The strongly connected components of the quoted pairs are kept up to
+     * date as pairs get their first quote. A new cycle must use an edge whose
+     * weight went down and whose currencies are in one component, so after
+     * a tick that settled without arbitrage, ticks whose quotes only lower
+     * rates within components (raise their weights), or change rates between
+     * them, skip the search. Such a tick reports `converged` with no passes and `searched
+     * == false`; the potentials it leaves unsettled are settled by the next
+     * search. Withdrawn quotes keep their pair in the components, which then
+     * over-approximate the cycles but never miss one.
+     */
+    class ArbitrageDetector {
+        ArbitrageOptions _options;
+        std::vector<uint32_t> _source;
+        CsrGraph _csr;
+        std::unordered_map<uint64_t, uint32_t> _pair_index{};
+        std::vector<double> _weight{};
+        std::vector<double> _dist{};
+        std::vector<uint8_t> _quoted{};  // 1 for the pairs quoted at least once
+        IncrementalScc _scc;             // components of the quoted pairs
+        bool _acyclic{true};             // no quote since the last settled search closes a cycle
+        NegCycleFinder<CsrGraph> _ncf;
+
+      public:
+        /**
+         * @brief Construct a new Arbitrage Detector object
+         *
+         * Every pair starts without a quote.
+         *
+         * @param[in] num_currencies number of currencies
+         * @param[in] from currency sold on each tradable pair
+         * @param[in] to currency bought on each tradable pair
+         * @param[in] options settings
+         * @exception std::invalid_argument if a pair is listed twice or a currency is out of range
+         */
+        ArbitrageDetector(size_t num_currencies, std::span<const uint32_t> from,
+                          std::span<const uint32_t> to, ArbitrageOptions options = {});
+
+        // `_ncf` refers to `_csr`
+        ArbitrageDetector(const ArbitrageDetector &) = delete;
+        auto operator=(const ArbitrageDetector &) -> ArbitrageDetector & = delete;
+
+        /**
+         * @brief Applies a batch of quotes without searching for arbitrage
+         *
+         * @exception std::invalid_argument for a pair that is not tradable
+         */
+        void update(std::span<const RateQuote> quotes);
+
+        /**
+         * @brief Applies a batch of quotes and searches for arbitrage within the pass budget
+         */
+        auto tick(std::span<const RateQuote> quotes) -> ArbitrageReport;
+
+        /** The strongly connected components of the pairs quoted so far */
+        auto components() const -> const IncrementalScc & { return this->_scc; }
+    };
+
+}  // namespace digraphx
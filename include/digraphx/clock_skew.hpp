@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+
+namespace digraphx {
+
+    /** Timing margins applied to every register pair */
+    struct ClockSkewOptions {
+        double setup_time{0.0};  ///< setup time of the capturing register
+        double hold_time{0.0};   ///< hold time of the capturing register
+    };
+
+    /**
+     * @brief Outcome of a clock skew scheduling run
+     *
+     * `value` is the minimum clock period or the maximum slack. `skew` is a
+     * clock arrival time per register that meets every constraint at that
+     * value (up to a relative tolerance of about 1e-9). `critical` lists the
+     * constraints of the critical cycle in traversal order, where constraint
+     * `2 * p` is the setup and `2 * p + 1` the hold constraint of pair `p`.
+     * If the hold constraints alone conflict, `feasible` is false and
+     * `critical` holds that conflicting cycle.
+     */
+    struct ClockSkewResult {
+        bool feasible{true};
+        double value{0.0};
+        std::vector<double> skew{};
+        std::vector<uint32_t> critical{};
+    };
+
+    /**
+     * @brief Clock skew scheduling by parametric negative cycle detection
+     *
+     * For a combinational path from register `i` to register `j` with maximum
+     * delay `D` and minimum delay `d`, clock arrival times `s` must satisfy
+     *
+     *     setup:  s[i] + D + setup_time <= s[j] + T
+     *     hold:   s[i] + d >= s[j] + hold_time
+     *
+     * i.e. two difference constraints per register pair. `min_period` finds the
+     * smallest period `T`, and `max_slack` the largest margin `M` that can be
+     * subtracted from the right-hand side of every constraint at a given
+     * period, both as a `min_cycle_ratio` on the constraint graph.
+     *
+     * The constraint graph is built once. `update_delay` changes the delays of
+     * a pair in O(1), and the next solve starts from the previous skew
+     * schedule, which usually needs far fewer relaxation passes than a cold
+     * start.
+     */
+    class ClockSkewScheduler {
+        ClockSkewOptions _options;
+        CsrGraph _csr{};
+        std::vector<double> _max_delay{};
+        std::vector<double> _min_delay{};
+        std::vector<double> _cost{};    // per constraint, see `_set_costs`
+        std::vector<double> _time{};    // per constraint, see `_set_costs`
+        std::vector<double> _weight{};  // scratch weights per constraint
+        std::vector<double> _dist{};    // potentials kept from the previous solve
+
+        void _set_costs(size_t pair);
+        auto _schedule(std::span<const double> cost, std::span<const double> time, double ratio)
+            -> std::vector<double>;
+
+      public:
+        /**
+         * @brief Construct a new Clock Skew Scheduler object
+         *
+         * @param[in] num_registers number of registers
+         * @param[in] from launching register of each pair
+         * @param[in] to capturing register of each pair
+         * @param[in] max_delay maximum path delay of each pair
+         * @param[in] min_delay minimum path delay of each pair
+         * @param[in] options timing margins
+         * @exception std::invalid_argument if the arrays differ in size or a register index is
+         * out of range
+         */
+        ClockSkewScheduler(size_t num_registers, std::span<const uint32_t> from,
+                           std::span<const uint32_t> to, std::span<const double> max_delay,
+                           std::span<const double> min_delay, ClockSkewOptions options = {});
+
+        auto num_registers() const -> size_t { return this->_csr.num_nodes(); }
+        auto num_pairs() const -> size_t { return this->_max_delay.size(); }
+
+        /**
+         * @brief Changes the path delays of one register pair
+         *
+         * @exception std::out_of_range if `pair` is not below `num_pairs()`
+         */
+        void update_delay(size_t pair, double max_delay, double min_delay);
+
+        /**
+         * @brief Finds the minimum clock period and a skew schedule achieving it
+         */
+        auto min_period() -> ClockSkewResult;
+
+        /**
+         * @brief Finds the maximum slack at clock period `period` and a schedule achieving it
+         */
+        auto max_slack(double period) -> ClockSkewResult;
+    };
+
+}  // namespace digraphx
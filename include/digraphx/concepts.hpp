@@ -0,0 +1,111 @@
+#pragma once
+
+#include <concepts>     // for integral, totally_ordered
+#include <cstddef>      // for size_t
+#include <iterator>     // for begin
+#include <ranges>       // for contiguous_range, sized_range
+#include <type_traits>  // for remove_cvref_t
+#include <utility>      // for declval
+
+/**
+ * @file concepts.hpp
+ * @brief Graph and mapping concepts shared by the solvers
+ *
+ * A digraph is a range of `(node, neighbors)` pairs, where `neighbors` is a
+ * range of `(node, edge)` pairs; `std::unordered_map<Node, std::list<std::pair<Node,
+ * Edge>>>`, `MapConstAdapter` over a `std::vector` and `CsrGraph` all qualify.
+ * The stronger concepts below describe properties that let the solvers use
+ * faster kernels, and are checked at compile time so users get those kernels
+ * just by passing a suitable graph and distance container.
+ */
+
+/** Node type of a digraph */
+template <typename DiGraph> using graph_node_t
+    = std::remove_cvref_t<decltype((*std::begin(std::declval<const DiGraph &>())).first)>;
+
+/** Neighbor range type of a digraph */
+template <typename DiGraph> using graph_neighbors_t
+    = std::remove_cvref_t<decltype((*std::begin(std::declval<const DiGraph &>())).second)>;
+
+/** Edge type of a digraph */
+template <typename DiGraph> using graph_edge_t = std::remove_cvref_t<
+    decltype((*std::begin(std::declval<const graph_neighbors_t<DiGraph> &>())).second)>;
+
+/** Node type on the target side of the edges of a digraph */
+template <typename DiGraph> using graph_target_t = std::remove_cvref_t<
+    decltype((*std::begin(std::declval<const graph_neighbors_t<DiGraph> &>())).first)>;
+
+/**
+ * @brief A range of `(node, neighbors)` pairs whose neighbors are `(node, edge)` pairs
+ */
+template <typename DiGraph>
+concept DiGraphLike = requires(const DiGraph &gra) {
+    (*std::begin(gra)).first;
+    (*std::begin((*std::begin(gra)).second)).second;
+    std::end(gra);
+} && std::same_as<graph_node_t<DiGraph>, graph_target_t<DiGraph>>;
+
+/**
+ * @brief Opt-in marker for digraphs whose nodes are exactly `0 .. size() - 1`
+ *
+ * Specialize it to `true` for graph types that guarantee dense node ids, as
+ * `MapAdapter`, `MapConstAdapter` and `CsrGraph` do. Such graphs get their
+ * per-node bookkeeping in flat arrays instead of hash maps.
+ */
+template <typename DiGraph> inline constexpr bool enable_dense_nodes = false;
+
+/**
+ * @brief A digraph with integral node ids `0 .. size() - 1`
+ */
+template <typename DiGraph>
+concept DenseNodeGraph = DiGraphLike<DiGraph> && std::integral<graph_node_t<DiGraph>>
+                         && enable_dense_nodes<DiGraph> && requires(const DiGraph &gra) {
+                                { gra.size() } -> std::convertible_to<size_t>;
+                            };
+
+/**
+ * @brief A dense digraph exposing its adjacency as CSR arrays
+ *
+ * `offsets()[u] .. offsets()[u + 1]` indexes the out-edges of node `u` in the
+ * contiguous `targets()` and `edge_ids()` arrays.
+ */
+template <typename DiGraph>
+concept ContiguousAdjacency = DenseNodeGraph<DiGraph> && requires(const DiGraph &gra) {
+    { gra.offsets() } -> std::ranges::contiguous_range;
+    { gra.targets() } -> std::ranges::contiguous_range;
+    { gra.edge_ids() } -> std::ranges::contiguous_range;
+};
+
+/**
+ * @brief A dense digraph exposing its adjacency as CSR arrays with gaps
+ *
+ * `starts()[u] .. starts()[u] + degrees()[u]` indexes the out-edges of node
+ * `u` in the contiguous `targets()` and `edge_ids()` arrays, which may hold
+ * unused slots after them, as in `DynamicCsrGraph`.
+ */
+template <typename DiGraph>
+concept SlackAdjacency = DenseNodeGraph<DiGraph> && requires(const DiGraph &gra) {
+    { gra.starts() } -> std::ranges::contiguous_range;
+    { gra.degrees() } -> std::ranges::contiguous_range;
+    { gra.targets() } -> std::ranges::contiguous_range;
+    { gra.edge_ids() } -> std::ranges::contiguous_range;
+};
+
+/**
+ * @brief A mutable map from `Key` to ordered values, such as a distance map
+ *
+ * The `dist` arguments of `NegCycleFinder::howard` and `max_parametric` are
+ * constrained by it.
+ */
+template <typename Mapping, typename Key>
+concept MappingLike = requires(Mapping &map, const Mapping &cmap, const Key &key) {
+    map[key] = cmap.at(key);
+    requires std::totally_ordered<std::remove_cvref_t<decltype(cmap.at(key))>>;
+};
+
+/**
+ * @brief A mapping stored as one contiguous array indexed by the key, e.g. `std::vector`
+ */
+template <typename Mapping>
+concept ContiguousMapping = std::ranges::contiguous_range<Mapping>
+                            && std::ranges::sized_range<Mapping>;
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>    // for size_t, ptrdiff_t
+#include <cstdint>    // for uint32_t
+#include <span>       // for span
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for pair
+#include <vector>
+
+#include "concepts.hpp"  // for enable_dense_nodes
+
+/**
+ * @brief Compressed sparse row (CSR) directed graph
+ *
+ * The `CsrGraph` class stores the out-edges of every node contiguously, which
+ * makes a full sweep over the edges a linear scan of two arrays. Nodes are the
+ * integers `0 .. num_nodes() - 1`. Each edge is identified by its index in the
+ * edge list the graph was built from, so edge attributes (cost, time, ...) can
+ * stay in the caller's arrays in their original order and be looked up by the
+ * edge id.
+ *
+ * Iterating a `CsrGraph` yields `(node, neighbors)` pairs, and iterating the
+ * neighbors yields `(node, edge)` pairs, so the graph can be passed directly
+ * to `NegCycleFinder`, `max_parametric` and `min_cycle_ratio`.
+ */
+class CsrGraph {
+  public:
+    using node_type = uint32_t;
+    using edge_type = uint32_t;
+
+    /**
+     * @brief Range of the out-edges of one node
+     */
+    class Neighbors {
+        const node_type *_targets;
+        const edge_type *_edges;
+        size_t _size;
+
+      public:
+        class iterator {
+            const node_type *_target{nullptr};
+            const edge_type *_edge{nullptr};
+
+          public:
+            using value_type = std::pair<node_type, edge_type>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const node_type *target, const edge_type *edge)
+                : _target{target}, _edge{edge} {}
+
+            auto operator*() const -> value_type { return {*_target, *_edge}; }
+            auto operator++() -> iterator & {
+                ++_target;
+                ++_edge;
+                return *this;
+            }
+            auto operator++(int) -> iterator {
+                auto old = *this;
+                ++*this;
+                return old;
+            }
+            auto operator==(const iterator &other) const -> bool {
+                return _target == other._target;
+            }
+        };
+
+        Neighbors(const node_type *targets, const edge_type *edges, size_t size)
+            : _targets{targets}, _edges{edges}, _size{size} {}
+
+        auto begin() const -> iterator { return {_targets, _edges}; }
+        auto end() const -> iterator { return {_targets + _size, _edges + _size}; }
+        auto size() const -> size_t { return _size; }
+        auto empty() const -> bool { return _size == 0; }
+    };
+
+    /**
+     * @brief Iterator over the `(node, neighbors)` pairs of the graph
+     */
+    class iterator {
+        const CsrGraph *_gra{nullptr};
+        node_type _node{0};
+
+      public:
+        using value_type = std::pair<node_type, Neighbors>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const CsrGraph *gra, node_type node) : _gra{gra}, _node{node} {}
+
+        auto operator*() const -> value_type { return {_node, _gra->neighbors(_node)}; }
+        auto operator++() -> iterator & {
+            ++_node;
+            return *this;
+        }
+        auto operator++(int) -> iterator {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        auto operator==(const iterator &other) const -> bool { return _node == other._node; }
+    };
+
+    CsrGraph() : _offsets(1, 0) {}
+
+    /**
+     * @brief Construct a new CSR graph from an edge list
+     *
+     * @param[in] num_nodes number of nodes of the graph
+     * @param[in] source source node of each edge
+     * @param[in] target target node of each edge
+     */
+    CsrGraph(size_t num_nodes, std::span<const node_type> source,
+             std::span<const node_type> target) {
+        this->assign(num_nodes, source, target);
+    }
+
+    /**
+     * @brief Rebuilds the graph from an edge list, reusing the allocated storage
+     *
+     * The edges are bucketed by their source node with a counting sort, which
+     * keeps the relative order of the out-edges of each node.
+     *
+     * @param[in] num_nodes number of nodes of the graph
+     * @param[in] source source node of each edge
+     * @param[in] target target node of each edge
+     */
+    void assign(size_t num_nodes, std::span<const node_type> source,
+                std::span<const node_type> target) {
+        if (source.size() != target.size()) {
+            throw std::invalid_argument("CsrGraph: source and target sizes differ");
+        }
+        this->_targets.clear();
+        this->_edges.clear();
+        this->_offsets.assign(num_nodes + 1, 0);
+        for (size_t i = 0; i != source.size(); ++i) {
+            if (source[i] >= num_nodes || target[i] >= num_nodes) {
+                this->_offsets.assign(1, 0);
+                throw std::invalid_argument("CsrGraph: node id out of range");
+            }
+            ++this->_offsets[source[i] + 1];
+        }
+        for (size_t utx = 0; utx != num_nodes; ++utx) {
+            this->_offsets[utx + 1] += this->_offsets[utx];
+        }
+        this->_targets.resize(source.size());
+        this->_edges.resize(source.size());
+        this->_fill.assign(this->_offsets.begin(), this->_offsets.end() - 1);
+        for (size_t i = 0; i != source.size(); ++i) {
+            const auto pos = this->_fill[source[i]]++;
+            this->_targets[pos] = target[i];
+            this->_edges[pos] = static_cast<edge_type>(i);
+        }
+    }
+
+    auto begin() const -> iterator { return {this, 0}; }
+    auto end() const -> iterator { return {this, static_cast<node_type>(this->num_nodes())}; }
+
+    /**
+     * @brief The out-edges of node `utx`
+     *
+     * @param[in] utx source node
+     * @return Neighbors
+     */
+    auto neighbors(node_type utx) const -> Neighbors {
+        const auto first = this->_offsets[utx];
+        return {this->_targets.data() + first, this->_edges.data() + first,
+                size_t(this->_offsets[utx + 1] - first)};
+    }
+
+    auto num_nodes() const -> size_t { return this->_offsets.size() - 1; }
+    auto num_edges() const -> size_t { return this->_targets.size(); }
+    auto size() const -> size_t { return this->num_nodes(); }
+
+    /** Position of the first out-edge of each node, plus a final end marker. */
+    auto offsets() const -> std::span<const edge_type> { return this->_offsets; }
+    /** Target node of each edge, in CSR order. */
+    auto targets() const -> std::span<const node_type> { return this->_targets; }
+    /** Original edge id of each edge, in CSR order. */
+    auto edge_ids() const -> std::span<const edge_type> { return this->_edges; }
+
+  private:
+    std::vector<edge_type> _offsets;
+    std::vector<node_type> _targets;
+    std::vector<edge_type> _edges;
+    std::vector<edge_type> _fill;  // scratch insertion cursors of `assign`
+};
+
+template <> inline constexpr bool enable_dense_nodes<CsrGraph> = true;
+
+/**
+ * @brief Edge attribute stored in an array indexed by the edge id
+ *
+ * Unlike a lambda, `EdgeWeights<T>` is a named type, so the solver templates
+ * called with it on a `CsrGraph` can be instantiated once in the DiGraphX
+ * library instead of in every translation unit (see `DIGRAPHX_CSR_DOMAINS`).
+ *
+ * @tparam T attribute type
+ */
+template <typename T> class EdgeWeights {
+    std::span<const T> _values;
+
+  public:
+    explicit EdgeWeights(std::span<const T> values) : _values{values} {}
+
+    auto operator()(CsrGraph::edge_type edge) const -> T { return this->_values[edge]; }
+
+    /** The attribute of every edge, indexed by the edge id */
+    auto values() const -> std::span<const T> { return this->_values; }
+};
+
+template <typename T> EdgeWeights(const std::vector<T> &) -> EdgeWeights<T>;
+
+/**
+ * @brief Applies `X` to every weight type precompiled for `CsrGraph`
+ *
+ * `NegCycleFinder<CsrGraph>::howard` and `min_cycle_ratio` on a `CsrGraph`
+ * with a `std::vector<T>` distance map and `EdgeWeights<T>` are explicitly
+ * instantiated in the library for these types, and declared `extern template`
+ * in their headers unless `DIGRAPHX_HEADER_ONLY` is defined.
+ */
+#define DIGRAPHX_CSR_DOMAINS(X) X(int32_t) X(int64_t) X(float) X(double)
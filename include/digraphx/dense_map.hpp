@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>  // for fill
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t
+#include <span>
+#include <stdexcept>  // for out_of_range
+#include <vector>
+
+/**
+ * @brief Map from small non-negative integer keys to values, stored in flat arrays
+ *
+ * `DenseMap` offers the subset of the `std::unordered_map` interface used by
+ * the solvers (`contains`, `at`, `operator[]`, `clear`), so it can replace a
+ * hash map for graphs whose node ids are `0 .. n - 1`. Lookups are plain array
+ * accesses, and `clear` keeps the storage for the next run.
+ *
+ * @tparam Key integral key type
+ * @tparam Value mapped type
+ */
+template <typename Key, typename Value> class DenseMap {
+    std::vector<Value> _values{};
+    std::vector<uint8_t> _present{};
+
+  public:
+    DenseMap() = default;
+
+    /**
+     * @brief Construct a new Dense Map object with room for the keys `0 .. size - 1`
+     *
+     * @param[in] size number of keys
+     */
+    explicit DenseMap(size_t size) : _values(size), _present(size, 0) {}
+
+    /**
+     * The function checks if a value is stored for the given key.
+     *
+     * @param[in] key The key to search for.
+     *
+     * @return true if the key is present, false otherwise.
+     */
+    auto contains(const Key &key) const -> bool {
+        return size_t(key) < this->_present.size() && this->_present[size_t(key)] != 0;
+    }
+
+    /**
+     * The function returns the value stored for the given key.
+     *
+     * @exception std::out_of_range if the key is not present
+     */
+    auto at(const Key &key) const -> const Value & {
+        if (!this->contains(key)) {
+            throw std::out_of_range("DenseMap::at");
+        }
+        return this->_values[size_t(key)];
+    }
+
+    /**
+     * The function returns a reference to the value of the given key, inserting a
+     * default-constructed value if the key is not present yet.
+     */
+    auto operator[](const Key &key) -> Value & {
+        const auto idx = size_t(key);
+        if (idx >= this->_present.size()) {
+            this->_values.resize(idx + 1);
+            this->_present.resize(idx + 1, 0);
+        }
+        this->_present[idx] = 1;
+        return this->_values[idx];
+    }
+
+    /**
+     * The function removes all keys while keeping the allocated storage.
+     */
+    void clear() { std::fill(this->_present.begin(), this->_present.end(), uint8_t{0}); }
+
+    /**
+     * The function makes the keys `0 .. size - 1` addressable through `values` and `flags`
+     * without inserting them.
+     */
+    void reserve(size_t size) {
+        if (size > this->_present.size()) {
+            this->_values.resize(size);
+            this->_present.resize(size, 0);
+        }
+    }
+
+    /** The value slot of every addressable key, for kernels that fill the map in bulk */
+    auto values() -> std::span<Value> { return this->_values; }
+
+    /** The presence flag (0 or 1) of every addressable key */
+    auto flags() -> std::span<uint8_t> { return this->_present; }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>  // for reverse
+#include <cstdint>    // for uint32_t
+#include <span>
+#include <stdexcept>  // for invalid_argument
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph, EdgeWeights
+#include "neg_cycle.hpp"  // for NegCycleFinder
+
+/**
+ * @file difference_constraints.hpp
+ * @brief Systems of difference constraints `x[v] - x[u] <= w`
+ *
+ * A system of difference constraints is feasible exactly when its constraint
+ * graph, with an edge `u -> v` of weight `w` per constraint, has no negative
+ * cycle. Starting all distances at 0 plays the role of the usual virtual
+ * source joined to every variable by a zero-weight edge, so no extra node or
+ * edges are added.
+ */
+
+/**
+ * @brief Outcome of `DifferenceConstraints::solve`
+ *
+ * If the system is feasible, `solution` holds the tightest solution: the
+ * componentwise largest `x` with every `x[i] <= 0`, i.e. the shortest path
+ * distances from the virtual source. Otherwise `cycle` lists the indices of
+ * constraints that form a negative cycle, in traversal order; adding them up
+ * gives the contradiction `0 <= sum of their w < 0`.
+ *
+ * @tparam T value type
+ */
+template <typename T> struct DifferenceConstraintsResult {
+    bool feasible{true};
+    std::vector<T> solution{};
+    std::vector<uint32_t> cycle{};
+};
+
+/**
+ * @brief Solver for systems of difference constraints given as bulk arrays
+ *
+ * The constraints are read straight from the caller's arrays: the variable
+ * indices are bucketed into a `CsrGraph` kept by the solver (and reused by the
+ * next `solve`), and the bounds are used in place through `EdgeWeights`, so
+ * they are never copied. The search runs `NegCycleFinder<CsrGraph>::howard`,
+ * which is precompiled and uses the ISA-dispatched relaxation kernel for the
+ * weight types in `DIGRAPHX_CSR_DOMAINS`.
+ *
+ * @tparam T value type
+ */
+template <typename T> class DifferenceConstraints {
+    CsrGraph _csr{};
+
+  public:
+    /**
+     * @brief Solves the system `x[to[i]] - x[from[i]] <= bound[i]` for every `i`
+     *
+     * @param[in] num_vars number of variables
+     * @param[in] from index of the subtracted variable of each constraint
+     * @param[in] to index of the bounded variable of each constraint
+     * @param[in] bound right-hand side of each constraint
+     * @return DifferenceConstraintsResult<T>
+     * @exception std::invalid_argument if the arrays differ in size or an index is not below
+     * `num_vars`
+     */
+    auto solve(size_t num_vars, std::span<const uint32_t> from, std::span<const uint32_t> to,
+               std::span<const T> bound) -> DifferenceConstraintsResult<T> {
+        if (bound.size() != from.size()) {
+            throw std::invalid_argument("DifferenceConstraints: bound size differs");
+        }
+        this->_csr.assign(num_vars, from, to);
+
+        auto result = DifferenceConstraintsResult<T>{};
+        result.solution.assign(num_vars, T(0));
+        auto ncf = NegCycleFinder<CsrGraph>(this->_csr);
+        for (const auto &cycle : ncf.howard(result.solution, EdgeWeights<T>(bound))) {
+            result.cycle = cycle;
+            break;
+        }
+        if (!result.cycle.empty()) {
+            std::reverse(result.cycle.begin(), result.cycle.end());
+            result.feasible = false;
+            result.solution.clear();
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Solves the system `x[to[i]] - x[from[i]] <= bound[i]` for every `i`
+ *
+ * See `DifferenceConstraints::solve`; keep a `DifferenceConstraints` object
+ * to reuse its storage over many systems.
+ */
+template <typename T>
+auto solve_difference_constraints(size_t num_vars, std::span<const uint32_t> from,
+                                  std::span<const uint32_t> to, std::span<const T> bound)
+    -> DifferenceConstraintsResult<T> {
+    return DifferenceConstraints<T>{}.solve(num_vars, from, to, bound);
+}
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>  // for max, fill
+#include <bit>        // for bit_width
+#include <cstddef>    // for size_t, ptrdiff_t
+#include <cstdint>    // for uint32_t
+#include <span>       // for span
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for pair
+#include <vector>
+
+#include "concepts.hpp"   // for enable_dense_nodes
+#include "csr_graph.hpp"  // for CsrGraph::Neighbors
+
+/**
+ * @brief CSR directed graph with slack between the out-edges of the nodes
+ *
+ * The `DynamicCsrGraph` class lays the out-edges of every node out
+ * contiguously, in node order, like `CsrGraph`, but leaves gaps after them in
+ * the manner of a packed memory array, so an edge can be added or removed
+ * without rebuilding the graph. Adding an edge to a node whose segment is
+ * full spreads the nodes of the smallest enclosing window of `2^k` nodes
+ * whose density stays below a bound, which falls from 1 for a single node to
+ * 3/4 for the whole graph; with no such window the storage doubles. This
+ * keeps an insertion at O(log^2 n) amortized slot moves for bounded degrees.
+ * Removing an edge shifts the later out-edges of its node down, and the
+ * storage is halved once it is less than a quarter full.
+ *
+ * Edge ids are handed out by `add_edge` and recycled after `remove_edge`, so
+ * edge attributes stay in arrays indexed by the id, of `edge_bound()`
+ * entries. The relative order of the out-edges of a node is kept.
+ *
+ * Iterating a `DynamicCsrGraph` yields `(node, neighbors)` pairs as a
+ * `CsrGraph` does, and `starts()`, `degrees()`, `targets()` and `edge_ids()`
+ * expose the slot arrays to the relaxation kernel of `NegCycleFinder` (see
+ * `SlackAdjacency`). Any change of the graph invalidates these views.
+ */
+class DynamicCsrGraph {
+  public:
+    using node_type = uint32_t;
+    using edge_type = uint32_t;
+    using Neighbors = CsrGraph::Neighbors;
+
+    /** Edge id of an empty slot, and slot of a free edge id */
+    static constexpr edge_type no_edge = ~edge_type(0);
+
+    /**
+     * @brief Iterator over the `(node, neighbors)` pairs of the graph
+     */
+    class iterator {
+        const DynamicCsrGraph *_gra{nullptr};
+        node_type _node{0};
+
+      public:
+        using value_type = std::pair<node_type, Neighbors>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(const DynamicCsrGraph *gra, node_type node) : _gra{gra}, _node{node} {}
+
+        auto operator*() const -> value_type { return {_node, _gra->neighbors(_node)}; }
+        auto operator++() -> iterator & {
+            ++_node;
+            return *this;
+        }
+        auto operator++(int) -> iterator {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        auto operator==(const iterator &other) const -> bool { return _node == other._node; }
+    };
+
+    DynamicCsrGraph() : _start(1, 0) {}
+
+    /**
+     * @brief Construct a new graph from an edge list, edge `i` taking id `i`
+     *
+     * @param[in] num_nodes number of nodes of the graph
+     * @param[in] source source node of each edge
+     * @param[in] target target node of each edge
+     * @exception std::invalid_argument if the sizes differ or a node id is out of range
+     */
+    DynamicCsrGraph(size_t num_nodes, std::span<const node_type> source,
+                    std::span<const node_type> target)
+        : _start(num_nodes + 1, 0), _degree(num_nodes, 0) {
+        if (source.size() != target.size()) {
+            throw std::invalid_argument("DynamicCsrGraph: source and target sizes differ");
+        }
+        for (size_t i = 0; i != source.size(); ++i) {
+            if (source[i] >= num_nodes || target[i] >= num_nodes) {
+                throw std::invalid_argument("DynamicCsrGraph: node id out of range");
+            }
+            ++this->_degree[source[i]];
+        }
+        // bucket the edges by source into the scratch arrays, as `CsrGraph::assign` does
+        auto fill = std::vector<size_t>(num_nodes + 1, 0);
+        for (size_t utx = 0; utx != num_nodes; ++utx) {
+            fill[utx + 1] = fill[utx] + this->_degree[utx];
+        }
+        this->_scratch_targets.resize(source.size());
+        this->_scratch_edges.resize(source.size());
+        for (size_t i = 0; i != source.size(); ++i) {
+            const auto pos = fill[source[i]]++;
+            this->_scratch_targets[pos] = target[i];
+            this->_scratch_edges[pos] = edge_type(i);
+        }
+        this->_source.assign(source.begin(), source.end());
+        this->_slot.assign(source.size(), 0);
+        this->_num_edges = source.size();
+        this->_relayout(capacity_for(source.size()), no_edge);
+    }
+
+    auto begin() const -> iterator { return {this, 0}; }
+    auto end() const -> iterator { return {this, static_cast<node_type>(this->num_nodes())}; }
+
+    /**
+     * @brief The out-edges of node `utx`
+     */
+    auto neighbors(node_type utx) const -> Neighbors {
+        const auto first = this->_start[utx];
+        return {this->_targets.data() + first, this->_edges.data() + first, this->_degree[utx]};
+    }
+
+    /** Adds a node without edges and returns its id. */
+    auto add_node() -> node_type {
+        this->_start.push_back(this->_start.back());
+        this->_degree.push_back(0);
+        return node_type(this->num_nodes() - 1);
+    }
+
+    /**
+     * @brief Adds the edge `utx -> vtx` after the other out-edges of `utx`
+     *
+     * @return the id of the new edge
+     * @exception std::invalid_argument if a node is out of range
+     */
+    auto add_edge(node_type utx, node_type vtx) -> edge_type {
+        if (utx >= this->num_nodes() || vtx >= this->num_nodes()) {
+            throw std::invalid_argument("DynamicCsrGraph: node id out of range");
+        }
+        if (this->_start[utx] + this->_degree[utx] == this->_start[utx + 1]) {
+            this->_make_room(utx);
+        }
+        auto edge = edge_type(this->_slot.size());
+        if (this->_free.empty()) {
+            this->_slot.push_back(0);
+            this->_source.push_back(utx);
+        } else {
+            edge = this->_free.back();
+            this->_free.pop_back();
+            this->_source[edge] = utx;
+        }
+        const auto pos = this->_start[utx] + this->_degree[utx]++;
+        this->_targets[pos] = vtx;
+        this->_edges[pos] = edge;
+        this->_slot[edge] = pos;
+        ++this->_num_edges;
+        return edge;
+    }
+
+    /**
+     * @brief Removes the edge `edge`, whose id may then be reused
+     *
+     * @exception std::invalid_argument if there is no such edge
+     */
+    void remove_edge(edge_type edge) {
+        if (!this->contains(edge)) {
+            throw std::invalid_argument("DynamicCsrGraph: no such edge");
+        }
+        const auto utx = this->_source[edge];
+        const auto last = this->_start[utx] + --this->_degree[utx];
+        for (auto pos = this->_slot[edge]; pos != last; ++pos) {
+            this->_targets[pos] = this->_targets[pos + 1];
+            this->_edges[pos] = this->_edges[pos + 1];
+            this->_slot[this->_edges[pos]] = pos;
+        }
+        this->_edges[last] = no_edge;
+        this->_slot[edge] = no_edge;
+        this->_free.push_back(edge);
+        --this->_num_edges;
+        if (this->capacity() > min_capacity && 4 * this->_num_edges < this->capacity()) {
+            this->_gather(0, this->num_nodes());
+            this->_relayout(capacity_for(this->_num_edges), no_edge);
+        }
+    }
+
+    /** Whether `edge` is the id of an edge of the graph */
+    auto contains(edge_type edge) const -> bool {
+        return edge < this->_slot.size() && this->_slot[edge] != no_edge;
+    }
+
+    /** Source node of the edge `edge` */
+    auto source(edge_type edge) const -> node_type { return this->_source[edge]; }
+
+    /** Target node of the edge `edge` */
+    auto target(edge_type edge) const -> node_type { return this->_targets[this->_slot[edge]]; }
+
+    auto num_nodes() const -> size_t { return this->_degree.size(); }
+    auto num_edges() const -> size_t { return this->_num_edges; }
+    auto size() const -> size_t { return this->num_nodes(); }
+
+    /** One more than the largest edge id in use or free, the size of edge attribute arrays */
+    auto edge_bound() const -> size_t { return this->_slot.size(); }
+
+    /** Number of slots, edges and gaps */
+    auto capacity() const -> size_t { return this->_targets.size(); }
+
+    /** Number of windows spread out or storage reallocations so far */
+    auto rebalances() const -> size_t { return this->_rebalances; }
+
+    /** Slot of the first out-edge of each node, plus the capacity at the end. */
+    auto starts() const -> std::span<const edge_type> { return this->_start; }
+    /** Out-degree of each node; the out-edges of `u` are slots `starts()[u] ..` on. */
+    auto degrees() const -> std::span<const edge_type> { return this->_degree; }
+    /** Target node of each slot, meaningless in the gaps. */
+    auto targets() const -> std::span<const node_type> { return this->_targets; }
+    /** Edge id of each slot, `no_edge` in the gaps. */
+    auto edge_ids() const -> std::span<const edge_type> { return this->_edges; }
+
+  private:
+    static constexpr size_t min_capacity = 64;
+
+    std::vector<edge_type> _start;
+    std::vector<edge_type> _degree{};
+    std::vector<node_type> _targets{};
+    std::vector<edge_type> _edges{};
+    std::vector<edge_type> _slot{};    // slot of each edge id
+    std::vector<node_type> _source{};  // source node of each edge id
+    std::vector<edge_type> _free{};    // edge ids to reuse
+    std::vector<node_type> _scratch_targets{};
+    std::vector<edge_type> _scratch_edges{};
+    size_t _num_edges{0};
+    size_t _rebalances{0};
+
+    static auto capacity_for(size_t num_edges) -> size_t {
+        return std::max(2 * num_edges, min_capacity);
+    }
+
+    /**
+     * The function gives node `utx` a free slot by spreading out the smallest
+     * aligned window of nodes around it whose density, counting the new
+     * edge, is within the bound of its level, or else by growing the storage.
+     */
+    void _make_room(node_type utx) {
+        const auto num_nodes = this->num_nodes();
+        const auto height = size_t(std::bit_width(num_nodes - 1));
+        auto first = size_t(utx);
+        auto last = first + 1;
+        auto edges = size_t(this->_degree[utx]) + 1;
+        for (size_t level = 1; level <= height; ++level) {
+            const auto lo = size_t(utx) >> level << level;
+            const auto hi = std::min(num_nodes, lo + (size_t(1) << level));
+            for (auto vtx = lo; vtx != first; ++vtx) {
+                edges += this->_degree[vtx];
+            }
+            for (auto vtx = last; vtx != hi; ++vtx) {
+                edges += this->_degree[vtx];
+            }
+            first = lo;
+            last = hi;
+            const auto slots = size_t(this->_start[last] - this->_start[first]);
+            // density bound 1 - level / (4 * height), checked in integers
+            if (4 * height * edges <= (4 * height - level) * slots) {
+                ++this->_rebalances;
+                this->_gather(first, last);
+                this->_layout(first, last, this->_start[first], slots, utx);
+                return;
+            }
+        }
+        ++this->_rebalances;
+        this->_gather(0, num_nodes);
+        this->_relayout(capacity_for(this->_num_edges + 1), utx);
+    }
+
+    /** Copies the out-edges of the nodes `first .. last - 1` into the scratch arrays */
+    void _gather(size_t first, size_t last) {
+        this->_scratch_targets.clear();
+        this->_scratch_edges.clear();
+        for (auto utx = first; utx != last; ++utx) {
+            const auto begin = this->_start[utx];
+            const auto end = begin + this->_degree[utx];
+            this->_scratch_targets.insert(this->_scratch_targets.end(),
+                                          this->_targets.begin() + begin,
+                                          this->_targets.begin() + end);
+            this->_scratch_edges.insert(this->_scratch_edges.end(), this->_edges.begin() + begin,
+                                        this->_edges.begin() + end);
+        }
+    }
+
+    /** Lays all the gathered edges out in fresh storage of `capacity` slots */
+    void _relayout(size_t capacity, node_type extra) {
+        this->_targets.assign(capacity, 0);
+        this->_edges.assign(capacity, no_edge);
+        this->_start.back() = edge_type(capacity);
+        this->_layout(0, this->num_nodes(), 0, capacity, extra);
+    }
+
+    /**
+     * The function writes the gathered out-edges of the nodes `first .. last
+     * - 1` back into the `slots` slots from `base` on, spreading the gaps
+     * evenly after them, with one slot more for the node `extra`.
+     */
+    void _layout(size_t first, size_t last, size_t base, size_t slots, node_type extra) {
+        const auto count = last - first;
+        const auto gap = slots - this->_scratch_edges.size() - (extra == no_edge ? 0 : 1);
+        auto pos = base;
+        auto read = size_t{0};
+        for (size_t idx = 0; idx != count; ++idx) {
+            const auto utx = first + idx;
+            const auto degree = size_t(this->_degree[utx]);
+            this->_start[utx] = edge_type(pos);
+            for (size_t i = 0; i != degree; ++i) {
+                this->_targets[pos + i] = this->_scratch_targets[read + i];
+                this->_edges[pos + i] = this->_scratch_edges[read + i];
+                this->_slot[this->_edges[pos + i]] = edge_type(pos + i);
+            }
+            read += degree;
+            const auto room = degree + gap * (idx + 1) / count - gap * idx / count
+                              + (utx == extra ? 1 : 0);
+            std::fill(this->_edges.begin() + std::ptrdiff_t(pos + degree),
+                      this->_edges.begin() + std::ptrdiff_t(pos + room), no_edge);
+            pos += room;
+        }
+    }
+};
+
+template <> inline constexpr bool enable_dense_nodes<DynamicCsrGraph> = true;
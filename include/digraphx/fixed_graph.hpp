@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <stdexcept>  // for invalid_argument
+#include <utility>    // for pair
+
+/**
+ * @file fixed_graph.hpp
+ * @brief Negative cycle detection for graphs whose size is known at compile time
+ *
+ * `FixedDiGraph<N, M>` and `FixedNegCycleFinder` keep every array in a
+ * `std::array`, so they never allocate, all loop bounds are compile-time
+ * constants the optimizer can unroll, and the whole check can run in a
+ * constant expression:
+ *
+ *     constexpr auto gra = FixedDiGraph<3, 3>({{{0, 1}, {1, 2}, {2, 0}}});
+ *     static_assert(has_negative_cycle(gra, std::array{1, 1, -3}));
+ *
+ * This suits small difference-constraint systems with a fixed structure that
+ * are solved in an inner loop.
+ */
+
+/**
+ * @brief Directed graph with `N` nodes and `M` edges stored in fixed-size arrays
+ *
+ * The edges are kept sorted by their source node (stably, like `CsrGraph`),
+ * and each edge is identified by its index in the edge list the graph was
+ * built from.
+ *
+ * @tparam N number of nodes
+ * @tparam M number of edges
+ */
+template <size_t N, size_t M> class FixedDiGraph {
+  public:
+    using node_type = uint32_t;
+    using edge_type = uint32_t;
+
+  private:
+    std::array<node_type, M> _sources{};
+    std::array<node_type, M> _targets{};
+    std::array<edge_type, M> _edges{};
+
+  public:
+    /**
+     * @brief Construct a new Fixed DiGraph object from an edge list
+     *
+     * @param[in] edges `(source, target)` of each edge
+     * @exception std::invalid_argument if a node id is not below `N`
+     */
+    explicit constexpr FixedDiGraph(const std::array<std::pair<node_type, node_type>, M> &edges) {
+        auto fill = std::array<size_t, N + 1>{};
+        for (const auto &[utx, vtx] : edges) {
+            if (utx >= N || vtx >= N) {
+                throw std::invalid_argument("FixedDiGraph: node id out of range");
+            }
+            ++fill[utx + 1];
+        }
+        for (size_t utx = 0; utx != N; ++utx) {
+            fill[utx + 1] += fill[utx];
+        }
+        for (size_t i = 0; i != M; ++i) {
+            const auto pos = fill[edges[i].first]++;
+            this->_sources[pos] = edges[i].first;
+            this->_targets[pos] = edges[i].second;
+            this->_edges[pos] = static_cast<edge_type>(i);
+        }
+    }
+
+    static constexpr auto num_nodes() -> size_t { return N; }
+    static constexpr auto num_edges() -> size_t { return M; }
+
+    /** Source node of each edge, sorted. */
+    constexpr auto sources() const -> const std::array<node_type, M> & { return this->_sources; }
+    /** Target node of each edge, in the order of `sources()`. */
+    constexpr auto targets() const -> const std::array<node_type, M> & { return this->_targets; }
+    /** Original edge id of each edge, in the order of `sources()`. */
+    constexpr auto edge_ids() const -> const std::array<edge_type, M> & { return this->_edges; }
+};
+
+/**
+ * @brief A cycle of at most `N` edges, listed backwards like `NegCycleFinder` cycles
+ */
+template <size_t N> struct FixedCycle {
+    std::array<uint32_t, N> edges{};
+    size_t size{0};
+
+    constexpr auto empty() const -> bool { return this->size == 0; }
+    constexpr auto begin() const { return this->edges.begin(); }
+    constexpr auto end() const { return this->edges.begin() + this->size; }
+};
+
+/**
+ * @brief Negative Cycle Finder by Howard's method on a `FixedDiGraph`
+ *
+ * The same algorithm as `NegCycleFinder::howard`, visiting the edges in the
+ * same order, with the predecessor and visited maps in `std::array`s. All
+ * member functions are `constexpr`.
+ *
+ * @tparam N number of nodes
+ * @tparam M number of edges
+ */
+template <size_t N, size_t M> class FixedNegCycleFinder {
+    using Node = uint32_t;
+    static constexpr auto none = Node(N);
+
+    const FixedDiGraph<N, M> &_digraph;
+    std::array<Node, N> _pred_node{};
+    std::array<uint32_t, N> _pred_edge{};
+
+    /**
+     * The function performs one relaxation step, see `NegCycleFinder`.
+     */
+    template <typename T>
+    constexpr auto _relax(std::array<T, N> &dist, const std::array<T, M> &weight) -> bool {
+        const auto &sources = this->_digraph.sources();
+        const auto &targets = this->_digraph.targets();
+        const auto &edges = this->_digraph.edge_ids();
+        auto changed = false;
+        for (size_t i = 0; i != M; ++i) {
+            const auto utx = sources[i];
+            const auto vtx = targets[i];
+            auto distance = dist[utx] + weight[edges[i]];
+            if (dist[vtx] > distance) {
+                dist[vtx] = distance;
+                this->_pred_node[vtx] = utx;
+                this->_pred_edge[vtx] = edges[i];
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * The function finds a node on a cycle of the policy graph, or returns `none`.
+     */
+    constexpr auto _find_cycle() const -> Node {
+        auto visited = std::array<Node, N>{};
+        visited.fill(none);
+        for (auto vtx = Node{0}; vtx != none; ++vtx) {
+            if (visited[vtx] != none) {
+                continue;
+            }
+            auto utx = vtx;
+            visited[utx] = vtx;
+            while (this->_pred_node[utx] != none) {
+                utx = this->_pred_node[utx];
+                if (visited[utx] != none) {
+                    if (visited[utx] == vtx) {
+                        return utx;
+                    }
+                    break;
+                }
+                visited[utx] = vtx;
+            }
+        }
+        return none;
+    }
+
+    constexpr auto _cycle_list(Node handle) const -> FixedCycle<N> {
+        auto cycle = FixedCycle<N>{};
+        auto vtx = handle;
+        do {
+            cycle.edges[cycle.size++] = this->_pred_edge[vtx];
+            vtx = this->_pred_node[vtx];
+        } while (vtx != handle);
+        return cycle;
+    }
+
+  public:
+    explicit constexpr FixedNegCycleFinder(const FixedDiGraph<N, M> &gra) : _digraph{gra} {}
+
+    /**
+     * The function finds a negative cycle using Howard's method.
+     *
+     * @param[in,out] dist distance of each node; on return without a cycle, a feasible solution
+     * of the difference constraints `dist[v] - dist[u] <= weight[e]` for every edge `e(u, v)`
+     * @param[in] weight weight of each edge, indexed by the edge id
+     * @return the first negative cycle found, or an empty cycle
+     */
+    template <typename T>
+    constexpr auto howard(std::array<T, N> &dist, const std::array<T, M> &weight)
+        -> FixedCycle<N> {
+        this->_pred_node.fill(none);
+        while (this->_relax(dist, weight)) {
+            const auto handle = this->_find_cycle();
+            if (handle != none) {
+                return this->_cycle_list(handle);
+            }
+        }
+        return FixedCycle<N>{};
+    }
+};
+
+/**
+ * @brief Checks a `FixedDiGraph` for a negative cycle, starting from the all-zero potential
+ *
+ * @param[in] gra the graph
+ * @param[in] weight weight of each edge, indexed by the edge id
+ * @return true if the graph has a negative cycle
+ */
+template <size_t N, size_t M, typename T>
+constexpr auto has_negative_cycle(const FixedDiGraph<N, M> &gra, const std::array<T, M> &weight)
+    -> bool {
+    auto dist = std::array<T, N>{};
+    auto ncf = FixedNegCycleFinder<N, M>(gra);
+    return !ncf.howard(dist, weight).empty();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <iosfwd>   // for istream, ostream
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace digraphx {
+
+    /** File formats understood by `read_graph` and `write_graph` */
+    enum class GraphFormat {
+        Dimacs,    ///< `p` header line, `a u v cost [time]` arc lines, 1-based nodes
+        EdgeList,  ///< `u v cost [time]` per line, 0-based nodes
+        Binary,    ///< fixed header followed by the raw edge arrays
+    };
+
+    /**
+     * @brief A weighted directed graph as a plain edge list
+     *
+     * Edge `i` goes from `source[i]` to `target[i]` with cost `cost[i]`. The
+     * `time` array is either empty (the file had no time column) or holds one
+     * transit time per edge.
+     */
+    struct GraphData {
+        size_t num_nodes{0};
+        std::vector<uint32_t> source{};
+        std::vector<uint32_t> target{};
+        std::vector<double> cost{};
+        std::vector<double> time{};
+
+        auto num_edges() const -> size_t { return this->source.size(); }
+        auto has_time() const -> bool { return !this->time.empty(); }
+    };
+
+    /**
+     * @brief Parses a format name (`dimacs`, `edgelist` or `binary`)
+     *
+     * @param[in] name format name
+     * @return GraphFormat
+     * @exception std::invalid_argument for an unknown name
+     */
+    auto parse_graph_format(std::string_view name) -> GraphFormat;
+
+    /**
+     * @brief Guesses the format of a graph file from its extension
+     *
+     * `.dimacs`, `.gr` and `.max` files are DIMACS, `.bin` and `.dgx` files are
+     * binary, anything else is read as an edge list.
+     *
+     * @param[in] path file name
+     * @return GraphFormat
+     */
+    auto guess_graph_format(std::string_view path) -> GraphFormat;
+
+    /**
+     * @brief Reads a graph from a stream
+     *
+     * @param[in] input stream positioned at the start of the graph
+     * @param[in] format format of the data
+     * @return GraphData
+     * @exception std::runtime_error if the data is malformed
+     */
+    auto read_graph(std::istream &input, GraphFormat format) -> GraphData;
+
+    /**
+     * @brief Reads a graph from a file
+     *
+     * @param[in] path file name
+     * @param[in] format format of the file
+     * @return GraphData
+     * @exception std::runtime_error if the file cannot be opened or is malformed
+     */
+    auto read_graph_file(const std::string &path, GraphFormat format) -> GraphData;
+
+    /**
+     * @brief Writes a graph to a stream
+     *
+     * @param[out] output destination stream
+     * @param[in] gra graph to write
+     * @param[in] format format of the data
+     */
+    void write_graph(std::ostream &output, const GraphData &gra, GraphFormat format);
+
+}  // namespace digraphx
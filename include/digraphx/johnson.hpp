@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>  // for fill, max, min, min_element
+#include <atomic>
+#include <bit>         // for bit_width
+#include <concepts>    // for integral
+#include <cstdint>     // for uint32_t, uint64_t
+#include <functional>  // for greater
+#include <limits>
+#include <queue>  // for priority_queue
+#include <span>
+#include <stdexcept>  // for invalid_argument
+#include <type_traits>  // for conditional_t
+#include <utility>      // for pair
+#include <vector>
+
+#include "csr_graph.hpp"    // for CsrGraph, EdgeWeights
+#include "neg_cycle.hpp"    // for NegCycleFinder
+#include "thread_team.hpp"  // for ThreadTeam
+
+/**
+ * @file johnson.hpp
+ * @brief Many-source shortest paths on graphs with negative edge weights
+ *
+ * When `NegCycleFinder::howard` finishes without finding a cycle, `dist` is a
+ * feasible potential `h`: every reduced weight `w(u, v) + h(u) - h(v)` is
+ * non-negative. Johnson's algorithm runs Dijkstra on the reduced weights and
+ * converts the distances back with `d(s, v) = d'(s, v) - h(s) + h(v)`.
+ */
+
+/**
+ * @brief Monotone priority queue of non-negative integer keys (radix heap)
+ *
+ * Keys popped never decrease, as in Dijkstra's algorithm, so an entry lives in
+ * the bucket of the highest bit in which its key differs from the last key
+ * popped, and each entry moves to a lower bucket at most 64 times.
+ */
+class RadixHeap {
+    using Entry = std::pair<uint64_t, uint32_t>;
+
+    std::vector<std::vector<Entry>> _buckets{65};
+    uint64_t _last{0};
+    size_t _size{0};
+
+    auto _bucket(uint64_t key) const -> size_t {
+        return size_t(std::bit_width(key ^ this->_last));
+    }
+
+  public:
+    auto empty() const -> bool { return this->_size == 0; }
+
+    /** The function removes all entries and resets the last key to 0, keeping the storage. */
+    void clear() {
+        for (auto &bucket : this->_buckets) {
+            bucket.clear();
+        }
+        this->_last = 0;
+        this->_size = 0;
+    }
+
+    /** The function inserts `node` with `key`, which must not be below the last key popped. */
+    void push(uint64_t key, uint32_t node) {
+        this->_buckets[this->_bucket(key)].emplace_back(key, node);
+        ++this->_size;
+    }
+
+    /** The function removes and returns an entry of minimum key. */
+    auto pop() -> Entry {
+        if (this->_buckets[0].empty()) {
+            auto idx = size_t{1};
+            while (this->_buckets[idx].empty()) {
+                ++idx;
+            }
+            auto &bucket = this->_buckets[idx];
+            this->_last = std::min_element(bucket.begin(), bucket.end())->first;
+            for (const auto &entry : bucket) {
+                this->_buckets[this->_bucket(entry.first)].push_back(entry);
+            }
+            bucket.clear();
+        }
+        --this->_size;
+        const auto entry = this->_buckets[0].back();
+        this->_buckets[0].pop_back();
+        return entry;
+    }
+};
+
+/**
+ * @brief Johnson reweighting and parallel Dijkstra over a `CsrGraph`
+ *
+ * The constructor finds the potential with `howard` (or takes one from the
+ * caller) and stores the reduced weights, after which any number of sources
+ * can be queried. `distances` hands the sources out to `threads` workers,
+ * each with its own heap and scratch arrays, and every worker writes the rows
+ * of its sources. The workers run on a thread team kept for the lifetime of
+ * the object, so repeated queries reuse its threads. Integral weights use a
+ * `RadixHeap`, floating point weights a binary heap; reduced floating point
+ * weights are clamped at 0 against rounding.
+ *
+ * @tparam T weight type
+ */
+template <typename T> class JohnsonShortestPaths {
+    const CsrGraph &_gra;
+    std::vector<T> _potential{};
+    std::vector<T> _reduced{};
+    std::vector<CsrGraph::edge_type> _cycle{};
+    mutable digraphx::ThreadTeam _team{};  // runs the workers of `distances`
+
+    void _reweight(std::span<const T> weight) {
+        const auto offsets = this->_gra.offsets();
+        const auto targets = this->_gra.targets();
+        const auto edges = this->_gra.edge_ids();
+        this->_reduced.assign(weight.size(), T(0));
+        for (uint32_t utx = 0; utx != this->_gra.num_nodes(); ++utx) {
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto edge = edges[pos];
+                const auto reduced
+                    = weight[edge] + this->_potential[utx] - this->_potential[targets[pos]];
+                if constexpr (std::integral<T>) {
+                    if (reduced < 0) {
+                        throw std::invalid_argument(
+                            "JohnsonShortestPaths: potential is not feasible");
+                    }
+                    this->_reduced[edge] = reduced;
+                } else {
+                    this->_reduced[edge] = std::max(reduced, T(0));
+                }
+            }
+        }
+    }
+
+    /** Dijkstra from `source` on the reduced weights, writing one row of distances */
+    template <typename Heap>
+    void _dijkstra(uint32_t source, Heap &heap, std::vector<T> &reduced_dist,
+                   std::span<T> row) const {
+        const auto offsets = this->_gra.offsets();
+        const auto targets = this->_gra.targets();
+        const auto edges = this->_gra.edge_ids();
+        std::fill(reduced_dist.begin(), reduced_dist.end(), unreachable);
+        reduced_dist[source] = T(0);
+        heap.push(T(0), source);
+        while (!heap.empty()) {
+            const auto [key, utx] = heap.pop();
+            if (T(key) != reduced_dist[utx]) {
+                continue;  // stale entry
+            }
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = targets[pos];
+                const auto distance = reduced_dist[utx] + this->_reduced[edges[pos]];
+                if (distance < reduced_dist[vtx]) {
+                    reduced_dist[vtx] = distance;
+                    heap.push(distance, vtx);
+                }
+            }
+        }
+        for (uint32_t vtx = 0; vtx != row.size(); ++vtx) {
+            row[vtx] = reduced_dist[vtx] == unreachable
+                           ? unreachable
+                           : reduced_dist[vtx] - this->_potential[source] + this->_potential[vtx];
+        }
+    }
+
+    /** Binary heap with the interface of `RadixHeap`, for floating point keys */
+    class BinaryHeap {
+        using Entry = std::pair<T, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> _queue{};
+
+      public:
+        auto empty() const -> bool { return this->_queue.empty(); }
+        void clear() { this->_queue = {}; }
+        void push(T key, uint32_t node) { this->_queue.emplace(key, node); }
+        auto pop() -> Entry {
+            const auto entry = this->_queue.top();
+            this->_queue.pop();
+            return entry;
+        }
+    };
+
+    using Heap = std::conditional_t<std::integral<T>, RadixHeap, BinaryHeap>;
+
+  public:
+    /** Distance of the nodes not reachable from a source */
+    static constexpr T unreachable = std::numeric_limits<T>::has_infinity
+                                         ? std::numeric_limits<T>::infinity()
+                                         : std::numeric_limits<T>::max();
+
+    /**
+     * @brief Construct a new Johnson Shortest Paths object, finding the potential with `howard`
+     *
+     * If the graph has a negative cycle, `feasible()` is false, `cycle()` returns it and no
+     * distances can be queried.
+     *
+     * @param[in] gra the graph, which must outlive this object
+     * @param[in] weight weight of each edge
+     */
+    JohnsonShortestPaths(const CsrGraph &gra, EdgeWeights<T> weight) : _gra{gra} {
+        this->_potential.assign(gra.num_nodes(), T(0));
+        auto ncf = NegCycleFinder<CsrGraph>(gra);
+        for (const auto &cycle : ncf.howard(this->_potential, weight)) {
+            this->_cycle = cycle;
+            return;
+        }
+        this->_reweight(weight.values());
+    }
+
+    /**
+     * @brief Construct a new Johnson Shortest Paths object from a known potential, e.g. the
+     * `dist` of a `howard` run that found no cycle
+     *
+     * @exception std::invalid_argument if `potential` has the wrong size, or some reduced integral
+     * weight is negative
+     */
+    JohnsonShortestPaths(const CsrGraph &gra, EdgeWeights<T> weight,
+                         std::span<const T> potential)
+        : _gra{gra}, _potential(potential.begin(), potential.end()) {
+        if (potential.size() != gra.num_nodes()) {
+            throw std::invalid_argument("JohnsonShortestPaths: potential size differs");
+        }
+        this->_reweight(weight.values());
+    }
+
+    /** The function tells whether the graph is free of negative cycles. */
+    auto feasible() const -> bool { return this->_cycle.empty(); }
+
+    /** The function returns a negative cycle of the graph, or an empty cycle if there is none. */
+    auto cycle() const -> const std::vector<CsrGraph::edge_type> & { return this->_cycle; }
+
+    /** The function returns the potential that makes all reduced weights non-negative. */
+    auto potential() const -> std::span<const T> { return this->_potential; }
+
+    /**
+     * @brief Shortest path distances from each of `sources`
+     *
+     * @param[in] sources source nodes
+     * @param[in] threads number of worker threads, at least 1
+     * @return row-major `sources.size() x num_nodes` distances, `unreachable` for nodes not
+     * reachable from a source
+     * @exception std::invalid_argument if the graph has a negative cycle or a source is out of
+     * range
+     */
+    auto distances(std::span<const uint32_t> sources, size_t threads = 1) const -> std::vector<T> {
+        if (!this->feasible()) {
+            throw std::invalid_argument("JohnsonShortestPaths: the graph has a negative cycle");
+        }
+        const auto num_nodes = size_t(this->_gra.num_nodes());
+        for (const auto source : sources) {
+            if (source >= num_nodes) {
+                throw std::invalid_argument("JohnsonShortestPaths: source out of range");
+            }
+        }
+        auto result = std::vector<T>(sources.size() * num_nodes);
+        auto next = std::atomic<size_t>{0};
+        auto worker = [&](size_t /* idx */) {
+            auto heap = Heap{};
+            auto reduced_dist = std::vector<T>(num_nodes);
+            for (auto idx = next++; idx < sources.size(); idx = next++) {
+                heap.clear();
+                this->_dijkstra(sources[idx], heap, reduced_dist,
+                                std::span<T>(result).subspan(idx * num_nodes, num_nodes));
+            }
+        };
+
+        threads = std::max<size_t>(1, std::min(threads, sources.size()));
+        this->_team.run(threads, worker);
+        return result;
+    }
+
+    /**
+     * @brief All-pairs shortest path distances, row `u` holding the distances from node `u`
+     */
+    auto all_pairs(size_t threads = 1) const -> std::vector<T> {
+        auto sources = std::vector<uint32_t>(this->_gra.num_nodes());
+        for (uint32_t vtx = 0; vtx != sources.size(); ++vtx) {
+            sources[vtx] = vtx;
+        }
+        return this->distances(sources, threads);
+    }
+};
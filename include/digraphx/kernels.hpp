@@ -0,0 +1,124 @@
+#pragma once
+
+#include <concepts>  // for same_as
+#include <cstdint>   // for uint8_t, uint32_t, int32_t, int64_t
+#include <span>
+#include <string_view>
+#include <utility>  // for pair
+
+/**
+ * @file kernels.hpp
+ * @brief Hot loops of the solvers, compiled for several instruction sets
+ *
+ * The DiGraphX library builds every kernel below once per instruction set
+ * level and picks the best level the CPU supports on first use, so a single
+ * binary runs the AVX2 code on Skylake or Zen machines and the AVX-512 code on
+ * Ice Lake or Zen 4 machines. Setting the environment variable `DIGRAPHX_ISA`
+ * to `generic`, `avx2` or `avx512` before the first call selects a lower level,
+ * e.g. to benchmark one variant against another; a level the CPU lacks is
+ * capped at the detected one. All variants give bit-identical results.
+ */
+namespace digraphx {
+
+    /** Weight types the kernels are compiled for */
+    template <typename T>
+    concept KernelDomain = std::same_as<T, int32_t> || std::same_as<T, int64_t>
+                           || std::same_as<T, float> || std::same_as<T, double>;
+
+    /** Weight types of the floating point kernels */
+    template <typename T>
+    concept FloatKernelDomain = std::same_as<T, float> || std::same_as<T, double>;
+
+    /** Instruction set levels of the kernels */
+    enum class Isa {
+        Generic,  ///< the compiler's baseline target
+        Avx2,     ///< AVX2 and BMI2 (Haswell, Skylake, Zen)
+        Avx512,   ///< AVX-512 F/VL/BW/DQ (Skylake-SP, Ice Lake, Zen 4)
+    };
+
+    /**
+     * @brief Parses an instruction set level name (`generic`, `avx2` or `avx512`)
+     *
+     * @exception std::invalid_argument for an unknown name
+     */
+    auto parse_isa(std::string_view name) -> Isa;
+
+    auto to_string(Isa isa) -> std::string_view;
+
+    /** The best level supported by this CPU and operating system */
+    auto detected_isa() -> Isa;
+
+    /** The level the kernels currently run, see `DIGRAPHX_ISA` */
+    auto active_isa() -> Isa;
+
+    /**
+     * @brief Selects the level the kernels run from now on
+     *
+     * @param[in] isa requested level, capped at `detected_isa()`
+     * @return the level actually selected
+     */
+    auto select_isa(Isa isa) -> Isa;
+
+    /**
+     * @brief One relaxation pass over a CSR graph
+     *
+     * Visits the out-edges of the nodes `0 .. n - 1` in CSR order and lowers
+     * `dist[v]` to `dist[u] + weight[e]` where that is smaller, recording the
+     * pair `(u, e)` in `pred[v]` and setting `has_pred[v]`. This is the loop
+     * of `NegCycleFinder::howard` for a `CsrGraph` with `EdgeWeights`.
+     *
+     * @param[in] offsets CSR offsets (`n + 1` entries)
+     * @param[in] targets target node of each CSR position
+     * @param[in] edge_ids edge id of each CSR position
+     * @param[in] weight weight of each edge, indexed by the edge id
+     * @param[in,out] dist distance of each node (`n` entries)
+     * @param[in,out] pred predecessor node and edge of each node (`n` entries)
+     * @param[in,out] has_pred non-zero where `pred` is set (`n` entries)
+     * @return true if some distance was lowered
+     */
+    auto relax_csr(std::span<const uint32_t> offsets, std::span<const uint32_t> targets,
+                   std::span<const uint32_t> edge_ids, std::span<const int32_t> weight,
+                   std::span<int32_t> dist, std::span<std::pair<uint32_t, uint32_t>> pred,
+                   std::span<uint8_t> has_pred) -> bool;
+    auto relax_csr(std::span<const uint32_t> offsets, std::span<const uint32_t> targets,
+                   std::span<const uint32_t> edge_ids, std::span<const int64_t> weight,
+                   std::span<int64_t> dist, std::span<std::pair<uint32_t, uint32_t>> pred,
+                   std::span<uint8_t> has_pred) -> bool;
+    auto relax_csr(std::span<const uint32_t> offsets, std::span<const uint32_t> targets,
+                   std::span<const uint32_t> edge_ids, std::span<const float> weight,
+                   std::span<float> dist, std::span<std::pair<uint32_t, uint32_t>> pred,
+                   std::span<uint8_t> has_pred) -> bool;
+    auto relax_csr(std::span<const uint32_t> offsets, std::span<const uint32_t> targets,
+                   std::span<const uint32_t> edge_ids, std::span<const double> weight,
+                   std::span<double> dist, std::span<std::pair<uint32_t, uint32_t>> pred,
+                   std::span<uint8_t> has_pred) -> bool;
+
+    /**
+     * @brief Precomputes the parametric weights `cost[e] - ratio * time[e]` of every edge
+     *
+     * @param[in] cost cost of each edge
+     * @param[in] time time of each edge
+     * @param[in] ratio the parameter
+     * @param[out] weight weight of each edge (same size as `cost`)
+     */
+    void parametric_weights(std::span<const float> cost, std::span<const float> time, float ratio,
+                            std::span<float> weight);
+    void parametric_weights(std::span<const double> cost, std::span<const double> time,
+                            double ratio, std::span<double> weight);
+
+    /**
+     * @brief Sums the cost and the time of the edges of a cycle
+     *
+     * The sums are accumulated in cycle order, as in `min_cycle_ratio`.
+     *
+     * @param[in] cycle edge ids of the cycle
+     * @param[in] cost cost of each edge
+     * @param[in] time time of each edge
+     * @return the pair (total cost, total time)
+     */
+    auto cycle_sums(std::span<const uint32_t> cycle, std::span<const float> cost,
+                    std::span<const float> time) -> std::pair<float, float>;
+    auto cycle_sums(std::span<const uint32_t> cycle, std::span<const double> cost,
+                    std::span<const double> time) -> std::pair<double, double>;
+
+}  // namespace digraphx
@@ -5,6 +5,8 @@
 #include <utility>
 // #include <vector>
 
+#include "concepts.hpp"  // for enable_dense_nodes
+
 /**
  * @brief Dict-like data structure by std::vector and Range
  *
@@ -211,3 +213,8 @@ template <typename Container> class MapConstAdapter {
      */
     auto end() const { return mapview.end(); }
 };
+
+template <typename Container> inline constexpr bool enable_dense_nodes<MapAdapter<Container>>
+    = true;
+template <typename Container> inline constexpr bool enable_dense_nodes<MapConstAdapter<Container>>
+    = true;
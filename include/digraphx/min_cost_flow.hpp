@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+
+namespace digraphx {
+
+    /**
+     * @brief Outcome of a minimum cost flow solve
+     *
+     * `flow[e]` is the flow on arc `e` of the network as given. When the
+     * supplies cannot be routed within the capacities, `feasible` is false and
+     * `flow` routes as much of them as possible at minimum cost.
+     */
+    struct MinCostFlowResult {
+        bool feasible{false};
+        int64_t cost{0};
+        std::vector<int64_t> flow{};
+        size_t iterations{0};  ///< cycles canceled or refine phases run
+    };
+
+    /**
+     * @brief Minimum cost flow by minimum mean cycle canceling
+     *
+     * The residual network lives in a `CsrGraph` built once by the
+     * constructor: arc `e` becomes the residual arcs `2 e` (forward, cost
+     * `c(e)`) and `2 e + 1` (backward, cost `-c(e)`). Only the weight array is
+     * mutated while flow moves; an arc without residual capacity weighs
+     * infinity, so it is never relaxed. Every node is also joined to an extra
+     * hub node by artificial arcs that cost more than any path of the network;
+     * `solve` starts with the supplies routed over them, which is a feasible
+     * flow whatever the network.
+     *
+     * Each iteration runs `min_cycle_ratio` with unit times from the ratio 0,
+     * which finds a residual cycle of minimum mean cost if one is negative,
+     * and pushes the bottleneck capacity around it. The distance array is
+     * kept between iterations and between calls of `solve`, so the potentials
+     * of one search warm start the next.
+     */
+    class MinCostFlow {
+        size_t _num_nodes;
+        size_t _num_arcs;
+        std::vector<int64_t> _cost;      // per residual arc
+        std::vector<int64_t> _residual;  // per residual arc
+        CsrGraph _csr{};
+        std::vector<double> _weight{};   // per residual arc, infinity when saturated
+        std::vector<double> _time{};     // all ones
+        std::vector<double> _dist{};
+
+      public:
+        /**
+         * @brief Construct a new Min Cost Flow object
+         *
+         * @param[in] num_nodes number of nodes
+         * @param[in] from tail of each arc
+         * @param[in] to head of each arc
+         * @param[in] capacity capacity of each arc, non-negative
+         * @param[in] cost cost per unit of flow on each arc
+         * @exception std::invalid_argument if the arrays differ in size, a node index is out of
+         * range or a capacity is negative
+         */
+        MinCostFlow(size_t num_nodes, std::span<const uint32_t> from, std::span<const uint32_t> to,
+                    std::span<const int64_t> capacity, std::span<const int64_t> cost);
+
+        /**
+         * @brief Finds a minimum cost flow meeting `supply` (positive at sources, negative at
+         * sinks)
+         *
+         * @exception std::invalid_argument if the supplies do not sum to zero
+         */
+        auto solve(std::span<const int64_t> supply) -> MinCostFlowResult;
+    };
+
+    /**
+     * @brief Minimum cost flow by cost-scaling push-relabel (Goldberg and Tarjan)
+     *
+     * A baseline for `MinCostFlow` on the same network, with the same
+     * arguments and result.
+     *
+     * @exception std::invalid_argument as `MinCostFlow`
+     */
+    auto min_cost_flow_cost_scaling(size_t num_nodes, std::span<const uint32_t> from,
+                                    std::span<const uint32_t> to,
+                                    std::span<const int64_t> capacity,
+                                    std::span<const int64_t> cost, std::span<const int64_t> supply)
+        -> MinCostFlowResult;
+
+}  // namespace digraphx
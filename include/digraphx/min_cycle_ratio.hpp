@@ -7,7 +7,11 @@ correctly by the compiler or interpreter. */
 #pragma once
 
 #include <algorithm>
+#include <span>
+#include <type_traits>  // for add_rvalue_reference_t, remove_cvref_t
 
+#include "csr_graph.hpp"   // for CsrGraph, EdgeWeights
+#include "kernels.hpp"     // for parametric_weights, cycle_sums
 #include "parametric.hpp"  // import max_parametric
 
 /**
@@ -22,11 +26,8 @@ correctly by the compiler or interpreter. */
  * @tparam DiGraph
  * @tparam Ratio
  */
-template <typename DiGraph, typename Ratio> class CycleRatioAPI {
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+template <DiGraphLike DiGraph, typename Ratio> class CycleRatioAPI {
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
 
     const DiGraph &gra;
@@ -106,11 +107,8 @@ template <typename DiGraph, typename Ratio> class CycleRatioAPI {
  * @tparam DiGraph
  * @tparam Ratio
  */
-template <typename DiGraph, typename Ratio> class MinCycleRatioSolver {
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+template <DiGraphLike DiGraph, typename Ratio> class MinCycleRatioSolver {
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
 
     const DiGraph &gra;
@@ -137,10 +135,56 @@ template <typename DiGraph, typename Ratio> class MinCycleRatioSolver {
         -> Cycle {
         auto omega = CycleRatioAPI<DiGraph, Ratio>(gra);
         auto solver = MaxParametricSolver(gra, omega);
-        return solver.run(dist, r0, std::move(dummy));
+        return solver.run(r0, dist, std::move(dummy));
     }
 };
 
+/**
+ * @brief `max_parametric` specialized for `min_cycle_ratio` on a `CsrGraph` with floating point
+ * `EdgeWeights`
+ *
+ * The parametric weights of all edges are precomputed once per ratio, and the weights and the
+ * cycle sums use the library kernels built for several instruction sets. The arithmetic is the
+ * same as in the generic path, so both return the same cycle. `relax` and `search` configure
+ * the `NegCycleFinder` of the rounds.
+ */
+template <digraphx::FloatKernelDomain T>
+auto min_cycle_ratio_csr(const CsrGraph &gra, T &r_opt, std::span<const T> cost,
+                         std::span<const T> time, std::vector<T> &dist,
+                         const digraphx::RelaxOptions &relax = {},
+                         CycleSearch search = CycleSearch::Policy)
+    -> std::vector<CsrGraph::edge_type> {
+    using Cycle = std::vector<CsrGraph::edge_type>;
+
+    auto weight = std::vector<T>(cost.size());
+    auto ncf = NegCycleFinder<CsrGraph>(gra);
+    ncf.set_relax_options(relax);
+    ncf.set_cycle_search(search);
+    auto r_min = r_opt;
+    auto c_min = Cycle{};
+    auto c_opt = Cycle{};
+
+    while (true) {
+        digraphx::parametric_weights(cost, time, r_opt, weight);
+        for (auto ci : ncf.howard(dist, EdgeWeights<T>(weight))) {
+            const auto [total_cost, total_time] = digraphx::cycle_sums(ci, cost, time);
+            auto ri = total_cost / total_time;
+            if (r_min > ri) {
+                r_min = ri;
+                c_min = ci;
+            }
+        }
+        if (r_min >= r_opt) {
+            break;
+        }
+
+        c_opt = c_min;
+        r_opt = r_min;
+    }
+
+    return c_opt;
+}
+
 /*!
  * @brief minimum cost-to-time cycle ratio problem
  *
@@ -161,18 +205,22 @@ template <typename DiGraph, typename Ratio> class MinCycleRatioSolver {
  * @param[in,out] dist
  * @return auto
  */
-template <typename DiGraph, typename Ratio, typename Fn1, typename Fn2, typename Mapping,
+template <DiGraphLike DiGraph, typename Ratio, typename Fn1, typename Fn2, typename Mapping,
           typename Domain>
 auto min_cycle_ratio(const DiGraph &gra, Ratio &r0, Fn1 &&get_cost, Fn2 &&get_time, Mapping &dist,
-                     Domain dummy) {
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+                     Domain dummy) -> std::vector<graph_edge_t<DiGraph>> {
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
     using cost_T = decltype(get_cost(std::declval<Edge>()));
     using time_T = decltype(get_time(std::declval<Edge>()));
 
+    if constexpr (std::same_as<DiGraph, CsrGraph> && digraphx::FloatKernelDomain<Ratio>
+                  && std::same_as<Mapping, std::vector<Ratio>> && std::same_as<Domain, Ratio>
+                  && std::same_as<std::remove_cvref_t<Fn1>, EdgeWeights<Ratio>>
+                  && std::same_as<std::remove_cvref_t<Fn2>, EdgeWeights<Ratio>>) {
+        return min_cycle_ratio_csr(gra, r0, get_cost.values(), get_time.values(), dist);
+    }
+
     auto calc_ratio = [&get_cost, &get_time](const Cycle &cycle) -> Ratio {
         auto total_cost = cost_T(0);
         auto total_time = time_T(0);
@@ -189,3 +237,23 @@ auto min_cycle_ratio(const DiGraph &gra, Ratio &r0, Fn1 &&get_cost, Fn2 &&get_ti
 
     return max_parametric(gra, r0, std::move(calc_weight), std::move(calc_ratio), dist, dummy);
 }
+
+/**
+ * Explicit instantiation of `min_cycle_ratio` on a `CsrGraph` with `double` ratios, a
+ * `std::vector<T>` distance map and both cost and time passed as `Fn` (`EdgeWeights<T>` as an
+ * rvalue, lvalue or const lvalue)
+ */
+#define DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(PREFIX, T, Fn)                                       \
+    PREFIX auto min_cycle_ratio<CsrGraph, double, Fn, Fn, std::vector<T>, T>(                  \
+        const CsrGraph &, double &, std::add_rvalue_reference_t<Fn>,                           \
+        std::add_rvalue_reference_t<Fn>, std::vector<T> &, T)                                  \
+        -> std::vector<CsrGraph::edge_type>;
+
+#ifndef DIGRAPHX_HEADER_ONLY
+#    define DIGRAPHX_EXTERN_MIN_CYCLE_RATIO(T)                                        \
+        DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(extern template, T, EdgeWeights<T>)         \
+        DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(extern template, T, EdgeWeights<T> &)       \
+        DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(extern template, T, const EdgeWeights<T> &)
+DIGRAPHX_CSR_DOMAINS(DIGRAPHX_EXTERN_MIN_CYCLE_RATIO)
+#    undef DIGRAPHX_EXTERN_MIN_CYCLE_RATIO
+#endif
@@ -5,12 +5,28 @@
 Negative cycle detection for weighed graphs.
 **/
 #include <cassert>
+#include <concepts>  // for floating_point
 #include <cppcoro/generator.hpp>
-#include <type_traits>  // for is_same_v
+#include <iterator>     // for begin, end
+#include <ranges>       // for data, size, range_value_t
+#include <span>
+#include <type_traits>  // for conditional_t, remove_cvref_t
 #include <unordered_map>
-#include <utility>  // for pair
+#include <utility>  // for pair, declval
 #include <vector>
 
+#include "concepts.hpp"   // for DiGraphLike, MappingLike, ContiguousAdjacency, SlackAdjacency
+#include "csr_graph.hpp"  // for CsrGraph, EdgeWeights
+#include "dense_map.hpp"  // for DenseMap
+#include "kernels.hpp"    // for KernelDomain
+#include "relaxer.hpp"    // for CsrRelaxer, RelaxOptions
+
+/** How `NegCycleFinder::howard` looks for negative cycles after a relaxation pass */
+enum class CycleSearch {
+    Policy,      ///< walk the predecessor (policy) graph, the default
+    Admissible,  ///< also a depth-first search of the admissible graph, to report cycles earlier
+};
+
 /*!
  * @brief Negative Cycle Finder by Howard's method
  *
@@ -31,23 +47,48 @@ Negative cycle detection for weighed graphs.
  *  2. BF detect whether there is a negative cycle at the fianl stage.
  *  3. BF restarts the solution (dist[utx]) every time.
  *
+ * Graphs with dense integer node ids (see `DenseNodeGraph`) keep the
+ * predecessor and visited maps in flat arrays, and CSR graphs with a
+ * contiguous distance array (see `ContiguousAdjacency`) are relaxed by a
+ * kernel that walks the CSR arrays directly, skipping the gaps of a
+ * `DynamicCsrGraph` (see `SlackAdjacency`). A `CsrGraph` with `EdgeWeights`
+ * runs the library's `digraphx::relax_csr`, built for several instruction sets,
+ * or the parallel push/pull passes selected by `set_relax_options`.
+ *
+ * A finder only reads the graph, and keeps the state of a search (the
+ * policy graph and relaxer buffers) to itself, while the distances are the
+ * caller's. Concurrent searches on one graph therefore each take a finder
+ * and a `dist` of their own and share the graph without copying it; pull
+ * passes can share its in-edges as well (see `digraphx::CsrTranspose`).
+ *
  * @tparam DiGraph
  */
-template <typename DiGraph>  //
+template <DiGraphLike DiGraph>  //
 class NegCycleFinder {
-    using Node1 = decltype((*std::declval<DiGraph>().begin()).first);
-    using Node = std::remove_cv_t<std::remove_reference_t<Node1>>;
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+    using Node = graph_node_t<DiGraph>;
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
-    using Node2 = decltype((*std::declval<Nbrs>().begin()).first);
-    using NodeTo = std::remove_cv_t<std::remove_reference_t<Node2>>;
-    static_assert(std::is_same_v<Node, NodeTo>, "NodeFrom should be equal to NodeTo");
+    template <typename Value> using NodeMap
+        = std::conditional_t<DenseNodeGraph<DiGraph>, DenseMap<Node, Value>,
+                             std::unordered_map<Node, Value>>;
 
-    std::unordered_map<Node, std::pair<Node, Edge>> _pred{};
+    NodeMap<std::pair<Node, Edge>> _pred{};
     const DiGraph &_digraph;
+    size_t _max_passes{0};  // 0 for no limit
+    size_t _passes{0};      // relaxation passes of the last `howard` call
+    bool _resume{false};    // the last call stopped at the limit, keep its policy graph
+    CycleSearch _search{CycleSearch::Policy};
+    size_t _search_period{1};  // passes between two admissible graph searches
+    digraphx::CsrRelaxer _relaxer{};
+
+    /** A node on the stack of the admissible graph search, with its next out-edge */
+    struct SearchFrame {
+        using Iter = decltype(std::begin(std::declval<const graph_neighbors_t<DiGraph> &>()));
+        Node node;
+        Iter pos;
+        Iter end;
+        Edge in;  // the edge from the node below on the stack
+    };
 
     /**
      * The function performs one relaxation step in a graph algorithm.
@@ -78,6 +119,75 @@ class NegCycleFinder {
         return changed;
     }
 
+    /**
+     * The function performs one relaxation step on a CSR graph with a contiguous distance array.
+     *
+     * It visits the edges in the same order as the generic `_relax`, but reads the adjacency
+     * straight from the CSR arrays and the distances through a raw pointer.
+     */
+    template <ContiguousMapping Mapping, typename Callable>
+        requires ContiguousAdjacency<DiGraph>
+    auto _relax(Mapping &dist, Callable &&get_weight) -> bool {
+        using Value = std::ranges::range_value_t<Mapping>;
+        if constexpr (std::same_as<DiGraph, CsrGraph> && digraphx::KernelDomain<Value>
+                      && std::same_as<std::remove_cvref_t<Callable>, EdgeWeights<Value>>) {
+            this->_pred.reserve(this->_digraph.size());
+            return this->_relaxer.relax(
+                this->_digraph, get_weight.values(),
+                std::span<Value>(std::ranges::data(dist), std::ranges::size(dist)),
+                this->_pred.values(), this->_pred.flags());
+        }
+        const auto offsets = this->_digraph.offsets();
+        const auto targets = this->_digraph.targets();
+        const auto edges = this->_digraph.edge_ids();
+        auto *dst = std::ranges::data(dist);
+        const auto num_nodes = Node(this->_digraph.size());
+        auto changed = false;
+        for (auto utx = Node{0}; utx != num_nodes; ++utx) {
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = targets[pos];
+                const auto edge = edges[pos];
+                auto distance = dst[utx] + get_weight(edge);
+                if (dst[vtx] > distance) {
+                    dst[vtx] = distance;
+                    this->_pred[vtx] = std::make_pair(utx, edge);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * The function performs one relaxation step on a CSR graph with gaps, such as a
+     * `DynamicCsrGraph`, with a contiguous distance array, skipping the unused slots.
+     */
+    template <ContiguousMapping Mapping, typename Callable>
+        requires SlackAdjacency<DiGraph>
+    auto _relax(Mapping &dist, Callable &&get_weight) -> bool {
+        const auto starts = this->_digraph.starts();
+        const auto degrees = this->_digraph.degrees();
+        const auto targets = this->_digraph.targets();
+        const auto edges = this->_digraph.edge_ids();
+        auto *dst = std::ranges::data(dist);
+        const auto num_nodes = Node(this->_digraph.size());
+        auto changed = false;
+        for (auto utx = Node{0}; utx != num_nodes; ++utx) {
+            const auto last = starts[utx] + degrees[utx];
+            for (auto pos = starts[utx]; pos != last; ++pos) {
+                const auto vtx = targets[pos];
+                const auto edge = edges[pos];
+                auto distance = dst[utx] + get_weight(edge);
+                if (dst[vtx] > distance) {
+                    dst[vtx] = distance;
+                    this->_pred[vtx] = std::make_pair(utx, edge);
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
     /**
      * The function checks if there is a negative cycle in a graph.
      *
@@ -108,6 +218,16 @@ class NegCycleFinder {
         return false;
     }
 
+    /**
+     * The function asserts that the cycle through `handle` is negative. It is kept out of `howard`
+     * because GCC 12 crashes on `assert` inside the body of a member coroutine.
+     */
+    template <typename Mapping, typename Callable>
+    void _assert_negative([[maybe_unused]] const Node &handle, [[maybe_unused]] const Mapping &dist,
+                          [[maybe_unused]] Callable &&get_weight) const {
+        assert(this->_is_negative(handle, dist, get_weight));
+    }
+
     /**
      * The function `_cycle_list` generates a cycle list by traversing a graph starting from a given
      * node.
@@ -136,17 +256,17 @@ class NegCycleFinder {
      * The function `_find_cycle` finds a cycle on a policy graph and returns it as a generator.
      */
     auto _find_cycle() -> cppcoro::generator<Node> {
-        auto visited = std::unordered_map<Node, Node>{};
+        auto visited = NodeMap<Node>{};
         for (const auto &result : this->_digraph) {
             const auto &vtx = result.first;
-            if (visited.find(vtx) != visited.end()) {  // contains vtx
+            if (visited.contains(vtx)) {
                 continue;
             }
             auto utx = vtx;
             visited[utx] = vtx;
-            while (this->_pred.find(utx) != this->_pred.end()) {
+            while (this->_pred.contains(utx)) {
                 utx = this->_pred[utx].first;
-                if (visited.find(utx) != visited.end()) {  // contains utx
+                if (visited.contains(utx)) {
                     if (visited[utx] == vtx) {
                         co_yield utx;
                     }
@@ -158,6 +278,72 @@ class NegCycleFinder {
         co_return;
     }
 
+    /**
+     * @brief Find negative cycles in the admissible graph
+     *
+     * The admissible graph holds the edges whose reduced weight `w(u, v) + dist[u] - dist[v]`
+     * is not positive, so each of its cycles has a non-positive weight; Cherkassky and
+     * Goldberg found that searching it catches a negative cycle several passes before the
+     * cycle closes in the predecessor graph. The search is a depth-first search with an
+     * explicit stack, and a back edge closes a cycle along the stack. A cycle that closes
+     * only through a node the search already finished is missed, which `howard` covers by
+     * walking the policy graph as well.
+     *
+     * @return the cycles of negative weight found, with their edges in the order of
+     * `_cycle_list`
+     */
+    template <typename Mapping, typename Callable>
+    auto _find_admissible_cycles(Mapping &dist, Callable &&get_weight) -> std::vector<Cycle> {
+        using Iter = typename SearchFrame::Iter;
+        auto range = NodeMap<std::pair<Iter, Iter>>{};
+        for (const auto &[utx, neighbors] : this->_digraph) {
+            range[utx] = {std::begin(neighbors), std::end(neighbors)};
+        }
+        auto cycles = std::vector<Cycle>{};
+        auto state = NodeMap<uint8_t>{};  // 1 while on the stack, 2 once finished
+        auto stack = std::vector<SearchFrame>{};
+        for (const auto &result : this->_digraph) {
+            const auto &root = result.first;
+            if (state.contains(root)) {
+                continue;
+            }
+            state[root] = 1;
+            stack.push_back({root, range[root].first, range[root].second, Edge{}});
+            while (!stack.empty()) {
+                auto &top = stack.back();
+                if (top.pos == top.end) {
+                    state[top.node] = 2;
+                    stack.pop_back();
+                    continue;
+                }
+                const auto [vtx, edge] = *top.pos;
+                ++top.pos;
+                const auto utx = top.node;
+                if (dist[vtx] < dist[utx] + get_weight(edge)) {
+                    continue;  // positive reduced weight
+                }
+                if (!state.contains(vtx)) {
+                    state[vtx] = 1;
+                    stack.push_back({vtx, range[vtx].first, range[vtx].second, edge});
+                    continue;
+                }
+                if (state[vtx] != 1) {
+                    continue;
+                }
+                auto cycle = Cycle{edge};
+                auto total = get_weight(edge);
+                for (auto idx = stack.size() - 1; stack[idx].node != vtx; --idx) {
+                    cycle.push_back(stack[idx].in);
+                    total += get_weight(stack[idx].in);
+                }
+                if (total < decltype(total)(0)) {
+                    cycles.push_back(std::move(cycle));
+                }
+            }
+        }
+        return cycles;
+    }
+
   public:
     /**
      * The constructor initializes a `NegCycleFinder` object with a given `DiGraph` object.
@@ -167,6 +353,52 @@ class NegCycleFinder {
      */
     explicit NegCycleFinder(const DiGraph &gra) : _digraph{gra} {}
 
+    /**
+     * The function limits the number of relaxation passes of each `howard` call, which bounds
+     * the work of a call on a large graph. A call that reaches the limit stops without
+     * reporting a cycle; `dist` and the policy graph keep the progress made, so the next call
+     * with the same `dist` continues from there. Edge weights may change in between, in which
+     * case cycles of the old policy graph that are no longer negative are not reported.
+     *
+     * @param[in] max_passes the maximum number of passes, 0 for no limit
+     */
+    void set_max_passes(size_t max_passes) { this->_max_passes = max_passes; }
+
+    /**
+     * The function returns the number of relaxation passes made by the last `howard` call.
+     */
+    auto passes() const -> size_t { return this->_passes; }
+
+    /**
+     * The function selects how a `CsrGraph` with `EdgeWeights` is relaxed, e.g. in parallel with
+     * `RelaxMode::PushPull` (see `digraphx::CsrRelaxer`). Other graphs always use one sequential
+     * sweep per pass.
+     *
+     * @param[in] options relaxation mode and threads
+     */
+    void set_relax_options(const digraphx::RelaxOptions &options) {
+        this->_relaxer.set_options(options);
+    }
+
+    /**
+     * The function selects how `howard` looks for negative cycles: by walking the predecessor
+     * graph after every pass (the default), or also by a depth-first search of the admissible
+     * graph after every `period` passes, which costs a pass over the edges but often finds
+     * cycles earlier. The predecessor graph is walked after every pass either way.
+     *
+     * @param[in] search the cycle search
+     * @param[in] period passes between two admissible graph searches, at least 1
+     */
+    void set_cycle_search(CycleSearch search, size_t period = 1) {
+        this->_search = search;
+        this->_search_period = period == 0 ? 1 : period;
+    }
+
+    /**
+     * The function returns the relaxer of a `CsrGraph`, e.g. for its pass statistics.
+     */
+    auto relaxer() const -> const digraphx::CsrRelaxer & { return this->_relaxer; }
+
     /**
      * The function "howard" finds a negative cycle in a graph using the Howard's algorithm.
      *
@@ -177,17 +409,69 @@ class NegCycleFinder {
      * retrieve the weight of an edge in the graph. It takes in two arguments: the source vertex and
      * the destination vertex of the edge, and returns the weight of the edge.
      */
-    template <typename Mapping, typename Callable> auto howard(Mapping &dist, Callable get_weight)
-        -> cppcoro::generator<Cycle> {
+    template <MappingLike<graph_node_t<DiGraph>> Mapping, typename Callable>
+    auto howard(Mapping &dist, Callable get_weight) -> cppcoro::generator<Cycle>;
+};
+
+// Defined outside the class so that it is not implicitly inline, which lets the
+// `extern template` declarations below take effect.
+template <DiGraphLike DiGraph>
+template <MappingLike<graph_node_t<DiGraph>> Mapping, typename Callable>
+auto NegCycleFinder<DiGraph>::howard(Mapping &dist, Callable get_weight)
+    -> cppcoro::generator<Cycle> {
+    using Value = std::remove_cvref_t<decltype(dist[std::declval<Node>()])>;
+    constexpr auto inexact = std::floating_point<Value>;
+    const auto resumed = this->_resume;
+    if (!resumed) {
         this->_pred.clear();
-        auto found = false;
-        while (!found && this->_relax(dist, get_weight)) {
-            for (auto vtx : this->_find_cycle()) {
-                assert(this->_is_negative(vtx, dist, get_weight));
-                co_yield this->_cycle_list(vtx);
+    }
+    this->_resume = false;
+    this->_passes = 0;
+    this->_relaxer.restart();
+    auto found = false;
+    while (!found) {
+        if (this->_max_passes != 0 && this->_passes == this->_max_passes) {
+            this->_resume = true;
+            break;
+        }
+        ++this->_passes;
+        if (!this->_relax(dist, get_weight)) {
+            break;
+        }
+        // The admissible graph search only reports cycles earlier: it misses those that close
+        // through a node it already finished, so the policy graph is still checked every pass.
+        if (this->_search == CycleSearch::Admissible
+            && this->_passes % this->_search_period == 0) {
+            for (auto &cycle : this->_find_admissible_cycles(dist, get_weight)) {
+                co_yield std::move(cycle);
                 found = true;
             }
+            if (found) {
+                break;
+            }
+        }
+        for (auto vtx : this->_find_cycle()) {
+            // A resumed call keeps policy cycles of the old edge weights, and with floating
+            // point distances rounding can close one of zero weight; with exact distances a
+            // policy cycle of a fresh call is always negative.
+            if ((resumed || inexact) && !this->_is_negative(vtx, dist, get_weight)) {
+                continue;
+            }
+            this->_assert_negative(vtx, dist, get_weight);
+            co_yield this->_cycle_list(vtx);
+            found = true;
         }
-        co_return;
     }
-};
+    co_return;
+}
+
+/** Explicit instantiation of `howard` on a `CsrGraph` for the weight type `T` */
+#define DIGRAPHX_HOWARD_INSTANCE(PREFIX, T)                                        \
+    PREFIX auto NegCycleFinder<CsrGraph>::howard(std::vector<T> &, EdgeWeights<T>) \
+        -> cppcoro::generator<std::vector<CsrGraph::edge_type>>;
+
+#ifndef DIGRAPHX_HEADER_ONLY
+#    define DIGRAPHX_EXTERN_HOWARD(T) DIGRAPHX_HOWARD_INSTANCE(extern template, T)
+DIGRAPHX_CSR_DOMAINS(DIGRAPHX_EXTERN_HOWARD)
+#    undef DIGRAPHX_EXTERN_HOWARD
+#endif
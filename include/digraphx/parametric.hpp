@@ -20,12 +20,9 @@
  * @tparam DiGraph
  * @tparam ParametricAPI
  */
-template <typename DiGraph, typename ParametricAPI> class MaxParametricSolver {
+template <DiGraphLike DiGraph, typename ParametricAPI> class MaxParametricSolver {
   public:
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
 
   private:
@@ -58,7 +55,7 @@ template <typename DiGraph, typename ParametricAPI> class MaxParametricSolver {
      *
      * @return The function `run` returns an object of type `Cycle`.
      */
-    template <typename Ratio, typename Mapping, typename Domain>
+    template <typename Ratio, MappingLike<graph_node_t<DiGraph>> Mapping, typename Domain>
     auto run(Ratio &r_opt, Mapping &dist, Domain /* dist type */) {
         auto get_weight = [this,
                            &r_opt](const Edge &edge) -> Domain {  // note!!!
@@ -71,7 +68,7 @@ template <typename DiGraph, typename ParametricAPI> class MaxParametricSolver {
 
         while (true) {
             for (auto ci : this->_ncf.howard(dist, std::move(get_weight))) {
-                auto ri = zero_cancel(ci);
+                auto ri = this->_omega.zero_cancel(ci);
                 if (r_min > ri) {
                     r_min = ri;
                     c_min = ci;
@@ -117,13 +114,11 @@ template <typename DiGraph, typename ParametricAPI> class MaxParametricSolver {
  *
  * @return the optimal value of parameter r and the critical cycle.
  */
-template <typename DiGraph, typename T, typename Fn1, typename Fn2, typename Mapping, typename D>
+template <DiGraphLike DiGraph, typename T, typename Fn1, typename Fn2,
+          MappingLike<graph_node_t<DiGraph>> Mapping, typename D>
 auto max_parametric(const DiGraph &gra, T &r_opt, Fn1 &&distance, Fn2 &&zero_cancel, Mapping &dist,
-                    D /* dist type*/) {
-    using Nbrs1 = decltype((*std::declval<DiGraph>().begin()).second);
-    using Nbrs = std::remove_cv_t<std::remove_reference_t<Nbrs1>>;
-    using Edge1 = decltype((*std::declval<Nbrs>().begin()).second);
-    using Edge = std::remove_cv_t<std::remove_reference_t<Edge1>>;
+                    D /* dist type*/) -> std::vector<graph_edge_t<DiGraph>> {
+    using Edge = graph_edge_t<DiGraph>;
     using Cycle = std::vector<Edge>;
 
     auto get_weight = [&distance, &r_opt](const Edge &edge) -> D {  // note!!!
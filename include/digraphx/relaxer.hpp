@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint32_t
+#include <span>
+#include <string_view>
+#include <utility>  // for pair
+#include <vector>
+
+#include "csr_graph.hpp"    // for CsrGraph
+#include "kernels.hpp"      // for KernelDomain
+#include "thread_team.hpp"  // for ThreadTeam
+
+namespace digraphx {
+
+    /** How `NegCycleFinder` relaxes a `CsrGraph` with `EdgeWeights` */
+    enum class RelaxMode {
+        Sweep,     ///< one pass over all edges in CSR order with `relax_csr` (the default)
+        PushPull,  ///< push from the active nodes, or pull over in-edges with several threads
+        Blocked,   ///< relax within cache-sized node blocks until stable, then between blocks
+        Async,     ///< threads relax queued nodes without passes, stealing work from each other
+        Delta,     ///< relax nodes in buckets of increasing distance (delta-stepping)
+        Deque,     ///< Pape-Levit: a deque whose relabeled nodes go to the front
+        Threshold, ///< Glover's threshold algorithm: relax the nodes below a threshold first
+        Adaptive,  ///< sweep, push or pull each pass, by the fraction of nodes lowered before
+    };
+
+    /**
+     * @brief Parses a relaxation mode name (`sweep`, `pushpull`, `blocked`, `async`, `delta`,
+     * `deque`, `threshold` or `adaptive`)
+     *
+     * @exception std::invalid_argument for an unknown name
+     */
+    auto parse_relax_mode(std::string_view name) -> RelaxMode;
+
+    auto to_string(RelaxMode mode) -> std::string_view;
+
+    /**
+     * @brief In-edge CSR of a `CsrGraph`, which pull passes read
+     *
+     * Building it costs about one pass over the edges. It is immutable once
+     * built, so the relaxers of several concurrent searches on one graph can
+     * share it through `RelaxOptions::transpose` instead of building their own.
+     */
+    struct CsrTranspose {
+        std::vector<uint32_t> offsets{0};
+        std::vector<uint32_t> sources{};  ///< source of each in-edge, grouped by target
+        std::vector<uint32_t> edges{};    ///< edge id of each in-edge
+
+        CsrTranspose() = default;
+        explicit CsrTranspose(const CsrGraph &gra);
+
+        /** Whether it may be the transpose of `gra`, judging by the sizes */
+        auto fits(const CsrGraph &gra) const -> bool {
+            return this->offsets.size() == gra.num_nodes() + 1
+                   && this->sources.size() == gra.targets().size();
+        }
+    };
+
+    /** Settings of a `CsrRelaxer` */
+    struct RelaxOptions {
+        RelaxMode mode{RelaxMode::Sweep};
+        size_t threads{1};               ///< worker threads of a pull pass, async epoch or bucket
+        double pull_fraction{0.05};      ///< pull from this fraction of active nodes on
+        double sweep_fraction{0.5};      ///< `Adaptive` sweeps from this active fraction on
+        double list_fraction{1.0 / 64};  ///< push from a list below it, scanning flags above
+        size_t block_size{0};            ///< nodes per block, 0 for about 512 KiB of node state
+        size_t local_passes{16};         ///< limit of the passes within one block
+        double epoch_edges{1.0};         ///< edges per epoch of the queue modes, as a fraction
+        double delta{0.0};               ///< bucket width, 0 to choose it from the weights
+        double threshold{0.25};          ///< `Threshold` spot between lowest and mean distance
+        const CsrTranspose *transpose{nullptr};  ///< shared in-edges of the graph, or none
+    };
+
+    /**
+     * @brief Relaxation passes over a `CsrGraph` in the mode chosen by `RelaxOptions`
+     *
+     * In `PushPull` mode the relaxer tracks the active nodes, whose distance
+     * changed in the previous pass (all nodes in the first one). A pass with
+     * few active nodes pushes along their out-edges on the calling thread. A
+     * pass with many active nodes pulls: the nodes are split into ranges of
+     * about equal in-degree, and each thread lowers the distances of its own
+     * range from the in-edges of active nodes, read from a transposed CSR
+     * that is built on the first pull and kept for the next ones (or shared
+     * by several relaxers through `RelaxOptions::transpose`). Every
+     * `dist[v]` and predecessor is written by the thread owning `v` only, so
+     * no read-modify-write atomics are needed and hub nodes cause no
+     * contention; distances are loaded and stored with relaxed `atomic_ref`
+     * accesses, which compile to plain moves.
+     *
+     * A pull pass reads the distances other threads are lowering, so the
+     * predecessor graph, and which of several negative cycles is found first,
+     * may differ from run to run; distances converge to the same values.
+     *
+     * In `Blocked` mode the nodes are cut into blocks of consecutive ids whose
+     * distances and predecessors fit in the L2 cache, and the out-edges of
+     * each node are split once into edges within its block and edges to other
+     * blocks. A pass visits the blocks with lowered nodes in order: it relaxes
+     * the edges within the block from the lowered nodes until none is left
+     * (or `local_passes` is reached, as a negative cycle inside the block
+     * never settles), and only then relaxes the edges leaving the block from
+     * every node it lowered. Most relaxations thus hit cached distances, and
+     * each block's distances are brought in from memory once per pass.
+     *
+     * In `Async` mode there are no passes. Each thread owns a queue of nodes
+     * to relax from, seeded with the active nodes; it pops a node, relaxes its
+     * out-edges and queues every node it lowered (once, while it waits),
+     * taking half of another thread's queue when its own runs dry. A node's
+     * distance and predecessor are changed together under a per-node spin
+     * lock, taken only after an unlocked check found an improvement, so the
+     * predecessor graph stays consistent with the distances. One call is an
+     * epoch that ends at quiescence, when every queue is empty and no node is
+     * being relaxed, or once about `epoch_edges` times the number of edges
+     * were relaxed, which a negative cycle would otherwise keep going
+     * forever; the caller then checks the predecessor graph for cycles and
+     * the nodes still queued seed the next epoch. A slow thread only delays
+     * the end of an epoch, not every pass.
+     *
+     * In `Delta` mode an epoch also runs until quiescence or the edge budget,
+     * but takes the queued nodes in buckets of width delta by distance, the
+     * lowest first. Edges lighter than delta, which include the negative
+     * ones, are relaxed from a bucket until it stops changing; the heavier
+     * edges, which cannot lead back into it, are relaxed once afterwards from
+     * every node the bucket held. A node lowered below the current bucket
+     * goes back into it. Once the parametric search has made most weights
+     * non-negative, nodes are mostly relaxed after their distance is final,
+     * as in Dijkstra's algorithm. Frontiers of at least 1024 nodes per thread
+     * are relaxed by `threads` threads with the per-node locks of `Async`.
+     * The default delta is twice the mean non-negative weight divided by the
+     * mean out-degree, the choice of Meyer and Sanders for random weights,
+     * computed at the start of every search.
+     *
+     * `Deque` and `Threshold` are the sequential label-correcting methods
+     * that do well on sparse road and grid graphs, with the epochs of
+     * `Async`. `Deque` is Pape and Levit's: a lowered node joins the back of
+     * the deque on its first visit and the front on later ones, as its
+     * successors were scanned with a distance now known to be too high.
+     * `Threshold` is Glover, Klingman and Phillips's: lowered nodes wait in a
+     * second queue, and when the first runs dry those within `threshold` of
+     * the way from the lowest to the mean waiting distance move over (at
+     * least a sixteenth of them, which keeps the rescans of the second queue
+     * linear in the scans).
+     *
+     * `Adaptive` picks the pass from the fraction of nodes lowered in the
+     * previous one, as early passes lower almost every node and late ones a
+     * few: from `sweep_fraction` on a serial `relax_csr` sweep, which streams
+     * the CSR with the vector kernels and finds its lowered nodes by
+     * comparing the distances with a copy; from `pull_fraction` on a parallel
+     * pull if `threads` is above 1; otherwise a push, scanning the active
+     * flags in node order from `list_fraction` on and following the active
+     * list below it.
+     */
+    class CsrRelaxer {
+        RelaxOptions _options{};
+        const CsrGraph *_graph{nullptr};  // the graph `_in` and `_ranges` were set up for
+        const CsrTranspose *_shared_in{nullptr};  // `options().transpose` if it fits, else none
+        CsrTranspose _own_in{};                   // the in-edges otherwise
+
+        auto _in() const -> const CsrTranspose & {
+            return this->_shared_in != nullptr ? *this->_shared_in : this->_own_in;
+        }
+        std::vector<uint32_t> _ranges{};  // node range boundaries of the pull threads
+        ThreadTeam _team{};               // runs the pull, async and delta-stepping passes
+        std::vector<uint8_t> _active{};
+        std::vector<uint8_t> _next_active{};
+        std::vector<uint32_t> _active_list{};
+        std::vector<uint32_t> _next_list{};
+        bool _all_active{true};
+        size_t _push_passes{0};
+        size_t _pull_passes{0};
+        size_t _sweep_passes{0};  // sweeps of `Adaptive`
+        // out-edges split by block for `Blocked`, where `_active` marks the lowered nodes
+        // still to relax from and `_next_active` those lowered in the current block
+        const CsrGraph *_blocked_graph{nullptr};
+        size_t _block_size{0};
+        std::vector<uint32_t> _intra_offsets{};
+        std::vector<uint32_t> _intra_targets{};
+        std::vector<uint32_t> _intra_edges{};
+        std::vector<uint32_t> _inter_offsets{};
+        std::vector<uint32_t> _inter_targets{};
+        std::vector<uint32_t> _inter_edges{};
+        std::vector<uint8_t> _block_active{};
+        size_t _blocked_passes{0};
+        size_t _local_passes{0};
+        // per-node spin locks of `Async`, where `_active_list` holds the nodes still queued
+        std::vector<uint8_t> _locks{};
+        size_t _async_epochs{0};
+        size_t _steals{0};
+        // buckets of `Delta`, where `_bucket_of` holds the bucket a node is queued in, so that
+        // entries left behind by a move to a lower bucket are skipped
+        std::vector<std::vector<uint32_t>> _buckets{};
+        std::vector<uint32_t> _bucket_of{};
+        double _delta{0.0};
+        size_t _bucket_phases{0};
+        std::vector<uint8_t> _scanned{};  // nodes scanned before in the search, for `Deque`
+        size_t _scans{0};
+
+        void _transpose(const CsrGraph &gra);
+        void _split_blocks(const CsrGraph &gra, size_t block_size);
+        template <KernelDomain T>
+        auto _blocked(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                      std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+        template <KernelDomain T>
+        auto _async(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                    std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+        template <KernelDomain T>
+        auto _delta_step(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                         std::span<std::pair<uint32_t, uint32_t>> pred,
+                         std::span<uint8_t> has_pred) -> bool;
+        template <KernelDomain T>
+        auto _label_correcting(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                               std::span<std::pair<uint32_t, uint32_t>> pred,
+                               std::span<uint8_t> has_pred) -> bool;
+        template <KernelDomain T>
+        auto _sweep(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                    std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+        template <KernelDomain T>
+        auto _push(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                   std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+        template <KernelDomain T>
+        auto _pull(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                   std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+
+      public:
+        CsrRelaxer() = default;
+        explicit CsrRelaxer(RelaxOptions options) { this->set_options(options); }
+
+        auto options() const -> const RelaxOptions & { return this->_options; }
+
+        /**
+         * @brief Changes the settings and drops the cached transposed CSR
+         *
+         * Call it again after modifying the graph in place.
+         *
+         * @exception std::invalid_argument if `local_passes` is 0
+         */
+        void set_options(RelaxOptions options);
+
+        /** Marks every node active, for the first pass of a search. */
+        void restart() { this->_all_active = true; }
+
+        /**
+         * @brief One relaxation pass (an epoch in the queue modes from `Async` on), with the
+         * arguments of `relax_csr`
+         *
+         * @return true if some distance was lowered
+         */
+        template <KernelDomain T>
+        auto relax(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                   std::span<std::pair<uint32_t, uint32_t>> pred, std::span<uint8_t> has_pred)
+            -> bool;
+
+        /** Number of push passes run so far */
+        auto push_passes() const -> size_t { return this->_push_passes; }
+
+        /** Number of pull passes run so far */
+        auto pull_passes() const -> size_t { return this->_pull_passes; }
+
+        /** Number of sweeps run so far by `Adaptive` */
+        auto sweep_passes() const -> size_t { return this->_sweep_passes; }
+
+        /** Number of blocked passes run so far */
+        auto blocked_passes() const -> size_t { return this->_blocked_passes; }
+
+        /** Number of passes within a block run so far by blocked passes */
+        auto local_passes() const -> size_t { return this->_local_passes; }
+
+        /** Number of async epochs run so far */
+        auto async_epochs() const -> size_t { return this->_async_epochs; }
+
+        /** Number of times an async thread took nodes from another thread's queue */
+        auto steals() const -> size_t { return this->_steals; }
+
+        /** Bucket width of the last delta epoch */
+        auto delta() const -> double { return this->_delta; }
+
+        /** Number of light or heavy edge phases run so far by delta epochs */
+        auto bucket_phases() const -> size_t { return this->_bucket_phases; }
+
+        /** Number of nodes scanned so far by deque and threshold epochs */
+        auto scans() const -> size_t { return this->_scans; }
+    };
+
+}  // namespace digraphx
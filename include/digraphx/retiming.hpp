@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+
+namespace digraphx {
+
+    /**
+     * @brief Outcome of `Retiming::min_period`
+     *
+     * `retiming[v]` is the lag `r(v)` of each gate; edge `e(u, v)` then holds
+     * `registers[e] = w(e) + r(v) - r(u) >= 0` registers. `cycle_bound` is the
+     * maximum cycle ratio (delay per register) of the circuit, a lower bound on
+     * any period.
+     */
+    struct RetimingResult {
+        double period{0.0};
+        double cycle_bound{0.0};
+        std::vector<int64_t> retiming{};
+        std::vector<int64_t> registers{};
+    };
+
+    /**
+     * @brief Leiserson-Saxe retiming for minimum clock period in O(V + E) memory
+     *
+     * Gates are nodes with a propagation delay, and every wire `e(u, v)`
+     * carries `w(e)` registers. Instead of the dense `W`/`D` matrices of the
+     * OPT algorithms, the period is searched between two bounds and every
+     * candidate is checked with the FEAS relaxation, which only needs the
+     * graph and a few per-node arrays:
+     *
+     *  - the maximum cycle ratio `max sum d / sum w`, found by `min_cycle_ratio`
+     *    on the circuit graph, and the largest gate delay are lower bounds;
+     *  - the minimum period is less than their sum (Papaefthymiou), and never
+     *    more than the period of the circuit as given.
+     *
+     * Each feasible check returns the period it actually achieves, which is a
+     * path delay, so the search ends on an achieved period; with integral
+     * delays it is exact, otherwise within a relative tolerance of 1e-9.
+     */
+    class Retiming {
+        std::vector<double> _delay;
+        std::vector<uint32_t> _weight;
+        CsrGraph _csr{};
+        // scratch arrays of `_arrival`
+        std::vector<double> _arrival_time{};
+        std::vector<uint32_t> _indegree{};
+        std::vector<uint32_t> _queue{};
+
+        auto _arrival(std::span<const int64_t> lag) -> double;
+
+      public:
+        /**
+         * @brief Construct a new Retiming object
+         *
+         * @param[in] delay propagation delay of each gate
+         * @param[in] from driving gate of each wire
+         * @param[in] to driven gate of each wire
+         * @param[in] registers number of registers on each wire
+         * @exception std::invalid_argument if the arrays differ in size, a gate index is out of
+         * range, a delay is negative, or the circuit has a cycle without registers
+         */
+        Retiming(std::span<const double> delay, std::span<const uint32_t> from,
+                 std::span<const uint32_t> to, std::span<const uint32_t> registers);
+
+        /**
+         * @brief Checks whether some retiming achieves the clock period `period` (FEAS)
+         *
+         * @param[in] period target clock period
+         * @param[out] lag the retiming found, if any
+         * @return the period achieved by `lag`, or a negative value if `period` is infeasible
+         */
+        auto feasible(double period, std::vector<int64_t> &lag) -> double;
+
+        /**
+         * @brief Finds the minimum clock period and a retiming achieving it
+         */
+        auto min_period() -> RetimingResult;
+    };
+
+}  // namespace digraphx
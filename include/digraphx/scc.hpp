@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint8_t, uint32_t
+#include <span>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+#include "relaxer.hpp"    // for CsrTranspose
+
+namespace digraphx {
+
+    /** Settings of `strongly_connected_components` */
+    struct SccOptions {
+        size_t threads{1};
+        size_t serial_below{size_t(1) << 16};  ///< nodes left to hand over to Tarjan's algorithm
+    };
+
+    /** Strongly connected components of a graph */
+    struct Components {
+        std::vector<uint32_t> component{};  ///< component of each node, in order of lowest node
+        uint32_t count{0};                  ///< number of components
+        size_t trimmed{0};                  ///< nodes found to be trivial components by trimming
+        size_t color_rounds{0};             ///< label propagation rounds of the coloring phase
+
+        /** Number of nodes of each component */
+        auto sizes() const -> std::vector<uint32_t> {
+            auto result = std::vector<uint32_t>(this->count, 0);
+            for (const auto comp : this->component) {
+                ++result[comp];
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Marks the nodes that are trivial components, found by trimming
+     *
+     * A node without in-edges or without out-edges from other nodes is on no
+     * cycle through other nodes, so it is a component of its own; removing it
+     * can leave more such nodes. Each thread peels the nodes of its range with
+     * a stack, and counts the in- and out-degrees of their neighbors down with
+     * atomic decrements, so a node is removed by the thread that takes its
+     * last in- or out-edge away. The total work is linear in the edges.
+     *
+     * @param[in] gra the graph
+     * @param[in] transpose the in-edges of `gra`
+     * @param[in] threads number of threads, at least 1
+     * @return 1 for each trimmed node, 0 for the others
+     */
+    auto trim_trivial(const CsrGraph &gra, const CsrTranspose &transpose, size_t threads = 1)
+        -> std::vector<uint8_t>;
+
+    /**
+     * @brief Strongly connected components of a `CsrGraph`
+     *
+     * With a single thread, or fewer than `serial_below` nodes, this is Tarjan's
+     * algorithm with an explicit stack. Otherwise the decomposition follows
+     * Hong, Rodia and Olukotun: trim the trivial components, take the
+     * component of the node with the largest degree product by a forward
+     * search and a backward search within the forward set, both level by
+     * level on all threads, and trim again. The many small components left
+     * are found by coloring (Orzan): every node takes the largest node id that
+     * reaches it, by rounds of parallel label propagation, and the nodes whose
+     * color is their own id are roots, whose components are the nodes of
+     * their color reaching them backwards, searched by the threads in parallel.
+     * Coloring and trimming repeat until fewer than `serial_below` nodes are
+     * left, which Tarjan's algorithm takes over.
+     *
+     * Components are numbered in the order of their lowest node, so the
+     * result does not depend on the number of threads.
+     */
+    auto strongly_connected_components(const CsrGraph &gra, const SccOptions &options = {})
+        -> Components;
+
+    /**
+     * @brief Strongly connected components of a `CsrGraph` whose in-edges are known
+     */
+    auto strongly_connected_components(const CsrGraph &gra, const CsrTranspose &transpose,
+                                       const SccOptions &options) -> Components;
+
+    /** The condensation of a graph */
+    struct Condensation {
+        CsrGraph dag{};                ///< one node per component, one edge per adjacent pair
+        std::vector<uint32_t> edge{};  ///< an edge of the graph behind each edge of `dag`
+    };
+
+    /**
+     * @brief The acyclic graph of the components of `gra` and the edges between them
+     */
+    auto condense(const CsrGraph &gra, const Components &scc) -> Condensation;
+
+    /**
+     * @brief The edges of `gra` within a component, in increasing order
+     *
+     * These are the edges on some cycle; the others can be dropped before a
+     * negative cycle or cycle ratio search without changing its outcome.
+     */
+    auto cyclic_edges(const CsrGraph &gra, const Components &scc) -> std::vector<uint32_t>;
+
+    /**
+     * @brief Strongly connected components of a graph that only gains edges
+     *
+     * Components are kept in a union-find structure together with a
+     * topological order of the graph of components (Pearce and Kelly). An
+     * edge that agrees with the order costs O(1). One that goes backwards in
+     * it triggers a forward search from its target and a backward search
+     * from its source, both bounded to the components ordered between them.
+     * If the forward search reaches the source, the components found by both
+     * searches, which are those on a path closing the new cycle, merge into
+     * one. The remaining components found are then reordered within their own
+     * positions: those reaching the source go before the merged one, and
+     * those reachable from the target go after it. The out- and in-edges of a
+     * merged component are the concatenation of those of its parts, the
+     * shorter lists appended to the longer.
+     */
+    class IncrementalScc {
+        std::vector<uint32_t> _parent{};
+        std::vector<uint32_t> _size{};   // nodes of each root's component
+        std::vector<uint32_t> _order{};  // position of each root in a topological order
+        std::vector<std::vector<uint32_t>> _out{};  // targets of the edges leaving a component
+        std::vector<std::vector<uint32_t>> _in{};   // sources of the edges entering it
+        std::vector<uint32_t> _forward_seen{};      // stamp of the last search that found a root
+        std::vector<uint32_t> _backward_seen{};
+        std::vector<uint32_t> _forward{};  // scratch lists of the searches
+        std::vector<uint32_t> _backward{};
+        std::vector<uint32_t> _stack{};
+        uint32_t _stamp{0};
+        uint32_t _next_order{0};
+        size_t _count{0};
+        size_t _merges{0};
+        size_t _reorders{0};
+
+        auto _root(uint32_t vtx) -> uint32_t;
+        void _search(uint32_t root, bool forward, uint32_t bound);
+        void _merge(std::span<const uint32_t> roots, uint32_t order);
+
+      public:
+        /** Each of `num_nodes` nodes starts as a component of its own. */
+        explicit IncrementalScc(size_t num_nodes = 0);
+
+        /** Adds a node without edges and returns its id. */
+        auto add_node() -> uint32_t;
+
+        /**
+         * @brief Adds the edge `utx -> vtx`
+         *
+         * @return true if it closed a cycle that merged components
+         * @exception std::invalid_argument if a node is out of range
+         */
+        auto add_edge(uint32_t utx, uint32_t vtx) -> bool;
+
+        /**
+         * @brief Adds a batch of edges
+         *
+         * @return the number of components merged away
+         */
+        auto add_edges(std::span<const uint32_t> source, std::span<const uint32_t> target)
+            -> size_t;
+
+        /** The representative node of the component of `vtx` */
+        auto find(uint32_t vtx) const -> uint32_t;
+
+        /** Whether `utx` and `vtx` are in one component, i.e. on a common cycle or equal */
+        auto same_component(uint32_t utx, uint32_t vtx) const -> bool {
+            return this->find(utx) == this->find(vtx);
+        }
+
+        /**
+         * @brief Position of the component of `vtx` in a topological order of the components
+         *
+         * Every edge between two components goes from a lower position to a higher one.
+         */
+        auto position(uint32_t vtx) const -> uint32_t { return this->_order[this->find(vtx)]; }
+
+        /** Number of nodes of the component of `vtx` */
+        auto component_size(uint32_t vtx) const -> uint32_t {
+            return this->_size[this->find(vtx)];
+        }
+
+        auto num_nodes() const -> size_t { return this->_parent.size(); }
+        auto num_components() const -> size_t { return this->_count; }
+
+        /** The components numbered as by `strongly_connected_components` */
+        auto components() const -> Components;
+
+        /** Number of components merged away so far */
+        auto merges() const -> size_t { return this->_merges; }
+
+        /** Number of edges so far that went backwards in the order and were searched */
+        auto reorders() const -> size_t { return this->_reorders; }
+    };
+
+}  // namespace digraphx
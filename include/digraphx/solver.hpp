@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "csr_graph.hpp"  // for CsrGraph
+#include "graph_io.hpp"   // for GraphData
+#include "relaxer.hpp"    // for RelaxOptions
+
+namespace digraphx {
+
+    /** Problems that can be solved on a `GraphData` */
+    enum class Problem {
+        NegCycle,    ///< find a cycle of negative total cost
+        CycleRatio,  ///< minimum cost-to-time cycle ratio
+        MeanCycle,   ///< minimum mean cycle (every edge takes unit time)
+    };
+
+    /** Algorithms available for the negative cycle search */
+    enum class Engine {
+        Howard,      ///< `NegCycleFinder::howard`
+        Admissible,  ///< `howard` searching the admissible graph for cycles
+    };
+
+    /**
+     * @brief Parses a problem name (`negcycle`, `ratio` or `mean`)
+     *
+     * @exception std::invalid_argument for an unknown name
+     */
+    auto parse_problem(std::string_view name) -> Problem;
+
+    /**
+     * @brief Parses an engine name (`howard` or `admissible`)
+     *
+     * @exception std::invalid_argument for an unknown name
+     */
+    auto parse_engine(std::string_view name) -> Engine;
+
+    auto to_string(Problem problem) -> std::string_view;
+    auto to_string(Engine engine) -> std::string_view;
+
+    /** Settings of a single `solve` call */
+    struct SolveOptions {
+        Problem problem{Problem::NegCycle};
+        Engine engine{Engine::Howard};
+        RelaxOptions relax{};  ///< relaxation policy and threads of the engine
+        bool prune{false};     ///< first drop the edges on no cycle (see `cyclic_edges`)
+    };
+
+    /**
+     * @brief Outcome of a single `solve` call
+     *
+     * `value` is the total cost of the negative cycle for `Problem::NegCycle`,
+     * and the optimal ratio (or mean) otherwise. The cycle is listed in
+     * traversal order: edge `cycle_edges[i]` leaves node `cycle_nodes[i]`.
+     */
+    struct SolveResult {
+        bool has_cycle{false};
+        double value{0.0};
+        std::vector<uint32_t> cycle_nodes{};
+        std::vector<uint32_t> cycle_edges{};
+        double build_ms{0.0};  ///< time spent building the CSR graph
+        double solve_ms{0.0};  ///< time spent in the solver itself
+    };
+
+    /**
+     * @brief Scratch storage of `solve`
+     *
+     * Passing the same workspace to consecutive `solve` calls reuses its
+     * buffers instead of allocating them for every graph. A workspace must not
+     * be shared by concurrent calls.
+     */
+    struct SolveWorkspace {
+        CsrGraph csr{};
+        std::vector<double> dist{};
+        std::vector<double> time{};    ///< unit edge times of the mean cycle problem
+        std::vector<double> weight{};  ///< edge weights of a target ratio query
+    };
+
+    /**
+     * @brief Solves `options.problem` on a graph
+     *
+     * @param[in] gra input graph
+     * @param[in] options problem and engine selection
+     * @return SolveResult
+     * @exception std::invalid_argument if the graph does not fit the problem,
+     * e.g. a cycle ratio problem on a graph without positive edge times
+     */
+    auto solve(const GraphData &gra, const SolveOptions &options) -> SolveResult;
+
+    /**
+     * @brief Solves `options.problem` on a graph using the buffers of `workspace`
+     */
+    auto solve(const GraphData &gra, const SolveOptions &options, SolveWorkspace &workspace)
+        -> SolveResult;
+
+    /**
+     * @brief A graph prepared once and then queried by any number of threads
+     *
+     * It holds the graph with its CSR form and in-edges, and is never
+     * modified after construction, so concurrent `solve` calls read it without
+     * locks or copies. Everything a query writes (distances, predecessors,
+     * relaxer state) lives in that call's `SolveWorkspace` and finder.
+     */
+    class SharedGraph {
+        GraphData _data;
+        CsrGraph _csr;
+        CsrTranspose _transpose;
+
+      public:
+        explicit SharedGraph(GraphData gra);
+
+        auto data() const -> const GraphData & { return this->_data; }
+        auto csr() const -> const CsrGraph & { return this->_csr; }
+        auto transpose() const -> const CsrTranspose & { return this->_transpose; }
+    };
+
+    /**
+     * @brief One query on a `SharedGraph`
+     *
+     * A query may replace the edge costs of the graph. For `Problem::NegCycle`
+     * a non-zero `ratio` looks for a cycle whose cost-to-time ratio is below
+     * it, i.e. a negative cycle of the weights `cost - ratio * time`, and
+     * `SolveResult::value` is the total of these weights along the cycle.
+     */
+    struct Query {
+        SolveOptions options{};
+        std::vector<double> cost{};  ///< costs of this query, empty for those of the graph
+        double ratio{0.0};           ///< target ratio of a negative cycle query
+    };
+
+    /**
+     * @brief Solves one query on a shared graph using the buffers of `workspace`
+     *
+     * The CSR graph of `workspace` is not used; the relaxation shares the
+     * in-edges of `gra`. `SolveOptions::prune` is ignored, as the edges of a
+     * shared graph are fixed; build it from a pruned graph instead.
+     *
+     * @exception std::invalid_argument if the query does not fit the graph
+     */
+    auto solve(const SharedGraph &gra, const Query &query, SolveWorkspace &workspace)
+        -> SolveResult;
+
+    /**
+     * @brief Solves independent queries on a shared graph concurrently
+     *
+     * Queries are handed out to `threads` workers, each with its own
+     * workspace, so results do not depend on the number of threads except for
+     * the timings and, with parallel relaxation, which of several cycles is
+     * reported.
+     *
+     * @return the result of each query, in the order of `queries`
+     * @exception std::invalid_argument the first error of a query, after all workers finished
+     */
+    auto solve_all(const SharedGraph &gra, std::span<const Query> queries, size_t threads = 1)
+        -> std::vector<SolveResult>;
+
+}  // namespace digraphx
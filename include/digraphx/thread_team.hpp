@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>    // for size_t
+#include <exception>  // for exception_ptr
+#include <functional>  // for function
+#include <future>
+#include <memory>  // for unique_ptr
+#include <mutex>
+#include <vector>
+
+class ThreadPool;
+
+namespace digraphx {
+
+    /**
+     * @brief Threads kept alive to run parallel loops, one at a time
+     *
+     * `run(count, worker)` calls `worker(idx)` for every `idx` below `count`,
+     * `worker(0)` on the calling thread and the others on the threads of a
+     * `ThreadPool` owned by the team, and returns when all calls have. The
+     * pool is started by the first run with more than one worker and grown
+     * when a run needs more threads, so a team made once per relaxer or
+     * decomposition pays for its threads once instead of on every pass. All
+     * workers of a run execute concurrently, so they may wait for each other.
+     *
+     * Runs on one team from several threads take turns. A copy of a team
+     * starts without threads of its own; a move takes the threads along.
+     */
+    class ThreadTeam {
+        std::unique_ptr<ThreadPool> _pool;
+        size_t _size{0};  // threads of `_pool`
+        std::vector<std::future<void>> _done{};
+        std::mutex _mutex{};
+
+        void _reserve(size_t threads);
+        auto _enqueue(std::function<void()> task) -> std::future<void>;
+
+      public:
+        ThreadTeam();
+        ThreadTeam(const ThreadTeam & /* other */);
+        ThreadTeam(ThreadTeam &&other) noexcept;
+        auto operator=(const ThreadTeam &other) -> ThreadTeam &;
+        auto operator=(ThreadTeam &&other) noexcept -> ThreadTeam &;
+        ~ThreadTeam();
+
+        /** Number of threads started so far, besides the calling one */
+        auto size() const -> size_t { return this->_size; }
+
+        /**
+         * @brief Calls `worker(idx)` for every `idx` below `count` and waits for all of them
+         *
+         * The first exception thrown by a worker, or by queuing the workers, is rethrown
+         * after all the workers started have returned.
+         */
+        template <typename Worker> void run(size_t count, Worker &&worker) {
+            if (count <= 1) {
+                if (count == 1) {
+                    worker(size_t{0});
+                }
+                return;
+            }
+            const auto lock = std::scoped_lock(this->_mutex);
+            this->_reserve(count - 1);
+            this->_done.clear();
+            this->_done.reserve(count - 1);
+            // The queued tasks refer to `worker`, so even when queuing fails partway the
+            // ones already queued are waited for before the exception leaves this frame.
+            auto error = std::exception_ptr{};
+            try {
+                for (size_t idx = 1; idx != count; ++idx) {
+                    this->_done.push_back(this->_enqueue([&worker, idx] { worker(idx); }));
+                }
+                worker(size_t{0});
+            } catch (...) {
+                error = std::current_exception();
+            }
+            for (auto &done : this->_done) {
+                try {
+                    done.get();
+                } catch (...) {
+                    error = error != nullptr ? error : std::current_exception();
+                }
+            }
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+
+}  // namespace digraphx
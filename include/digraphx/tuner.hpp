@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <iosfwd>   // for istream, ostream
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "graph_io.hpp"  // for GraphData
+#include "relaxer.hpp"   // for RelaxOptions
+#include "solver.hpp"    // for Engine, Problem, SolveOptions
+
+namespace digraphx {
+
+    /** Cheap statistics of a graph that the fastest configuration depends on */
+    struct GraphProfile {
+        size_t num_nodes{0};
+        size_t num_edges{0};
+        double mean_degree{0.0};
+        double degree_skew{0.0};        ///< largest in- or out-degree over the mean degree
+        size_t num_sccs{0};             ///< strongly connected components
+        size_t largest_scc{0};          ///< nodes of the largest component
+        double negative_fraction{0.0};  ///< fraction of the edges with a negative cost
+        double locality{0.0};           ///< fraction of the edges between nearby node ids
+    };
+
+    /**
+     * @brief Computes the profile of a graph in linear time
+     */
+    auto profile_graph(const GraphData &gra) -> GraphProfile;
+
+    /**
+     * @brief Key of the graph family of a profile
+     *
+     * Graphs of one family have the same order of magnitude of nodes, mean
+     * degree and degree skew, and fall in the same coarse buckets of SCC
+     * coverage, negative costs and locality, e.g. `n16-d2-s3-c4-g1-l0`.
+     */
+    auto graph_family(const GraphProfile &profile) -> std::string;
+
+    /** Engine and relaxation chosen for a graph family */
+    struct TuneChoice {
+        Engine engine{Engine::Howard};
+        RelaxOptions relax{};
+        double trial_ms{0.0};  ///< time of the winning trial, 0 if chosen without trials
+    };
+
+    /** Settings of an `AutoTuner` */
+    struct TunerOptions {
+        bool trials{false};        ///< time brief trial solves instead of trusting the rules
+        size_t max_threads{1};     ///< largest thread count to choose
+        size_t trial_passes{32};   ///< pass limit of each trial
+    };
+
+    /**
+     * @brief Picks the engine, relaxation mode and threads of `solve` for a graph
+     *
+     * `choose` profiles the graph and looks its family and problem up in a
+     * table. On a miss it either applies a few rules drawn from the
+     * benchmarks (see `rules`) or, with `TunerOptions::trials`, times the
+     * first parametric round of every candidate configuration, capped at
+     * `trial_passes` passes, and keeps the fastest. The table can be written
+     * and read back, so a tuning run over the benchmark inputs produces a
+     * table that later runs load without any trials. `choose` may be called
+     * from several threads.
+     */
+    class AutoTuner {
+        TunerOptions _options{};
+        std::map<std::string, TuneChoice> _table{};
+        mutable std::mutex _mutex{};
+
+        auto _trial(const GraphData &gra, Problem problem, const TuneChoice &choice) const
+            -> double;
+
+      public:
+        AutoTuner() = default;
+        explicit AutoTuner(TunerOptions options) : _options{options} {}
+
+        /**
+         * @brief The configuration for `gra`, from the table or tuned and stored in it
+         */
+        auto choose(const GraphData &gra, Problem problem) -> TuneChoice;
+
+        /**
+         * @brief Solve options of `base` with the engine and relaxation chosen for `gra`
+         */
+        auto tune(const GraphData &gra, const SolveOptions &base) -> SolveOptions;
+
+        /**
+         * @brief The configuration the rules give for a profile
+         *
+         * Graphs without cycles take one `Sweep` per pass. Graphs with few
+         * negative costs take the Pape-Levit deque, which settles them in
+         * about one scan per node. Large graphs take `Adaptive` on all
+         * threads, or `Blocked` with a single thread if their edges are mostly
+         * local. All others take `Adaptive`.
+         */
+        static auto rules(const GraphProfile &profile, size_t max_threads) -> TuneChoice;
+
+        /**
+         * @brief Reads table lines `family problem engine mode threads`, replacing entries
+         *
+         * @exception std::runtime_error for a malformed line
+         */
+        void read_table(std::istream &input);
+
+        /** Writes the table in the format of `read_table` */
+        void write_table(std::ostream &output) const;
+
+        /** Number of entries in the table */
+        auto size() const -> size_t;
+    };
+
+}  // namespace digraphx
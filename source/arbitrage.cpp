@@ -0,0 +1,127 @@
+#include <fmt/format.h>
+
+#include <algorithm>  // for reverse, fill
+#include <charconv>   // for from_chars
+#include <cmath>      // for log, exp
+#include <digraphx/arbitrage.hpp>
+#include <istream>
+#include <limits>
+#include <stdexcept>  // for invalid_argument, runtime_error
+#include <string>
+
+using namespace digraphx;
+
+namespace {
+
+    auto pair_key(uint32_t from, uint32_t to) -> uint64_t {
+        return uint64_t(from) << 32U | uint64_t(to);
+    }
+
+    auto quote_weight(double rate) -> double {
+        return rate > 0.0 ? -std::log(rate) : std::numeric_limits<double>::infinity();
+    }
+
+    template <typename T> auto parse_field(const char *&pos, const char *end, T &value) -> bool {
+        while (pos != end && (*pos == ' ' || *pos == '\t')) {
+            ++pos;
+        }
+        const auto [ptr, ec] = std::from_chars(pos, end, value);
+        pos = ptr;
+        return ec == std::errc{};
+    }
+
+}  // namespace
+
+auto digraphx::read_rate_ticks(std::istream &input) -> std::vector<RateTick> {
+    auto ticks = std::vector<RateTick>{};
+    auto line = std::string{};
+    for (size_t lineno = 1; std::getline(input, line); ++lineno) {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        auto tick = RateTick{};
+        const auto *pos = line.data() + first;
+        const auto *end = line.data() + line.size();
+        if (!parse_field(pos, end, tick.time) || !parse_field(pos, end, tick.quote.from)
+            || !parse_field(pos, end, tick.quote.to) || !parse_field(pos, end, tick.quote.rate)) {
+            throw std::runtime_error(fmt::format("line {}: expected 'time from to rate'", lineno));
+        }
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
+ArbitrageDetector::ArbitrageDetector(size_t num_currencies, std::span<const uint32_t> from,
+                                     std::span<const uint32_t> to, ArbitrageOptions options)
+    : _options{options},
+      _source(from.begin(), from.end()),
+      _csr(num_currencies, from, to),
+      _weight(from.size(), std::numeric_limits<double>::infinity()),
+      _dist(num_currencies, 0.0),
+      _quoted(from.size(), 0),
+      _scc(num_currencies),
+      _ncf{_csr} {
+    for (size_t i = 0; i != from.size(); ++i) {
+        if (!this->_pair_index.try_emplace(pair_key(from[i], to[i]), uint32_t(i)).second) {
+            throw std::invalid_argument(
+                fmt::format("ArbitrageDetector: pair {} -> {} listed twice", from[i], to[i]));
+        }
+    }
+    this->_ncf.set_max_passes(options.max_passes);
+}
+
+void ArbitrageDetector::update(std::span<const RateQuote> quotes) {
+    for (const auto &quote : quotes) {
+        const auto it = this->_pair_index.find(pair_key(quote.from, quote.to));
+        if (it == this->_pair_index.end()) {
+            throw std::invalid_argument(fmt::format(
+                "ArbitrageDetector: pair {} -> {} is not tradable", quote.from, quote.to));
+        }
+        const auto idx = it->second;
+        const auto weight = quote_weight(quote.rate);
+        if (quote.rate > 0.0 && this->_quoted[idx] == 0) {
+            this->_quoted[idx] = 1;
+            this->_scc.add_edge(quote.from, quote.to);
+        }
+        if (weight < this->_weight[idx] && this->_scc.same_component(quote.from, quote.to)) {
+            this->_acyclic = false;
+        }
+        this->_weight[idx] = weight;
+    }
+}
+
+auto ArbitrageDetector::tick(std::span<const RateQuote> quotes) -> ArbitrageReport {
+    this->update(quotes);
+
+    auto report = ArbitrageReport{};
+    if (this->_acyclic) {
+        report.converged = true;
+        return report;
+    }
+    report.searched = true;
+    auto found = false;
+    for (auto cycle : this->_ncf.howard(this->_dist, EdgeWeights<double>(this->_weight))) {
+        found = true;
+        std::reverse(cycle.begin(), cycle.end());
+        auto opportunity = ArbitrageCycle{};
+        auto log_gain = 0.0;
+        for (const auto edge : cycle) {
+            opportunity.currencies.push_back(this->_source[edge]);
+            log_gain -= this->_weight[edge];
+        }
+        opportunity.profit = std::exp(log_gain) - 1.0;
+        if (opportunity.profit >= this->_options.min_profit) {
+            report.cycles.push_back(std::move(opportunity));
+        }
+    }
+    report.passes = this->_ncf.passes();
+    report.converged = !found
+                       && (this->_options.max_passes == 0
+                           || report.passes < this->_options.max_passes);
+    this->_acyclic = report.converged;
+    if (found) {
+        std::fill(this->_dist.begin(), this->_dist.end(), 0.0);
+    }
+    return report;
+}
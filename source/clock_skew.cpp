@@ -0,0 +1,162 @@
+#include <algorithm>  // for max, min, reverse
+#include <cmath>      // for abs
+#include <digraphx/clock_skew.hpp>
+#include <digraphx/kernels.hpp>  // for parametric_weights
+#include <digraphx/min_cycle_ratio.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <limits>
+#include <stdexcept>  // for invalid_argument, out_of_range, runtime_error
+
+using namespace digraphx;
+
+namespace {
+
+    /** Lists a cycle found by the solvers in traversal order. */
+    auto traversal_order(std::vector<uint32_t> cycle) -> std::vector<uint32_t> {
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+
+}  // namespace
+
+ClockSkewScheduler::ClockSkewScheduler(size_t num_registers, std::span<const uint32_t> from,
+                                       std::span<const uint32_t> to,
+                                       std::span<const double> max_delay,
+                                       std::span<const double> min_delay,
+                                       ClockSkewOptions options)
+    : _options{options},
+      _max_delay(max_delay.begin(), max_delay.end()),
+      _min_delay(min_delay.begin(), min_delay.end()) {
+    const auto num_pairs = from.size();
+    if (to.size() != num_pairs || max_delay.size() != num_pairs
+        || min_delay.size() != num_pairs) {
+        throw std::invalid_argument("ClockSkewScheduler: array sizes differ");
+    }
+    // Constraint 2p is the setup edge j -> i, constraint 2p + 1 the hold edge i -> j.
+    auto source = std::vector<uint32_t>(2 * num_pairs);
+    auto target = std::vector<uint32_t>(2 * num_pairs);
+    for (size_t pair = 0; pair != num_pairs; ++pair) {
+        source[2 * pair] = to[pair];
+        target[2 * pair] = from[pair];
+        source[2 * pair + 1] = from[pair];
+        target[2 * pair + 1] = to[pair];
+    }
+    this->_csr.assign(num_registers, source, target);
+    this->_cost.resize(2 * num_pairs);
+    this->_time.resize(2 * num_pairs);
+    this->_weight.resize(2 * num_pairs);
+    this->_dist.assign(num_registers, 0.0);
+    for (size_t pair = 0; pair != num_pairs; ++pair) {
+        this->_set_costs(pair);
+    }
+}
+
+/**
+ * With the parameter `r = -T`, the setup constraint `s[i] - s[j] <= T - D - setup_time` has the
+ * weight `cost - r * time` for `cost = -(D + setup_time)` and `time = 1`, and the hold
+ * constraint `s[j] - s[i] <= d - hold_time` has `cost = d - hold_time` and `time = 0`.
+ */
+void ClockSkewScheduler::_set_costs(size_t pair) {
+    this->_cost[2 * pair] = -(this->_max_delay[pair] + this->_options.setup_time);
+    this->_time[2 * pair] = 1.0;
+    this->_cost[2 * pair + 1] = this->_min_delay[pair] - this->_options.hold_time;
+    this->_time[2 * pair + 1] = 0.0;
+}
+
+void ClockSkewScheduler::update_delay(size_t pair, double max_delay, double min_delay) {
+    if (pair >= this->num_pairs()) {
+        throw std::out_of_range("ClockSkewScheduler::update_delay");
+    }
+    this->_max_delay[pair] = max_delay;
+    this->_min_delay[pair] = min_delay;
+    this->_set_costs(pair);
+}
+
+/**
+ * The function computes potentials meeting the constraints at the parameter `ratio`. At the
+ * optimum the critical cycle has zero weight, which rounding may turn slightly negative, so the
+ * parameter is backed off by a tolerance that grows until no negative cycle is left.
+ */
+auto ClockSkewScheduler::_schedule(std::span<const double> cost, std::span<const double> time,
+                                   double ratio) -> std::vector<double> {
+    auto ncf = NegCycleFinder<CsrGraph>(this->_csr);
+    auto tol = 1e-12 * (1.0 + std::abs(ratio));
+    for (auto attempt = 0; attempt != 16; ++attempt, tol *= 4.0) {
+        parametric_weights(cost, time, ratio - tol, this->_weight);
+        auto found = false;
+        for (const auto &cycle : ncf.howard(this->_dist, EdgeWeights<double>(this->_weight))) {
+            found = !cycle.empty();
+            break;
+        }
+        if (!found) {
+            return this->_dist;
+        }
+    }
+    throw std::runtime_error("ClockSkewScheduler: no schedule within tolerance");
+}
+
+auto ClockSkewScheduler::min_period() -> ClockSkewResult {
+    auto result = ClockSkewResult{};
+    if (this->num_pairs() == 0) {
+        result.skew.assign(this->num_registers(), 0.0);
+        return result;
+    }
+
+    // The hold constraints do not depend on the period, so they must be feasible on their own.
+    const auto inf = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i != this->_weight.size(); ++i) {
+        this->_weight[i] = this->_time[i] == 0.0 ? this->_cost[i] : inf;
+    }
+    auto ncf = NegCycleFinder<CsrGraph>(this->_csr);
+    for (const auto &cycle : ncf.howard(this->_dist, EdgeWeights<double>(this->_weight))) {
+        result.feasible = false;
+        result.critical = traversal_order(cycle);
+        break;
+    }
+    if (!result.feasible) {
+        std::fill(this->_dist.begin(), this->_dist.end(), 0.0);
+        return result;
+    }
+
+    // Every pair alone needs T >= D + setup_time - d + hold_time; starting just below the
+    // largest of these bounds makes the first round find a critical cycle.
+    auto bound = -inf;
+    for (size_t pair = 0; pair != this->num_pairs(); ++pair) {
+        bound = std::max(bound, -this->_cost[2 * pair] - this->_cost[2 * pair + 1]);
+    }
+    auto ratio = 1.0 - bound;
+    const auto cycle
+        = min_cycle_ratio(this->_csr, ratio, EdgeWeights<double>(this->_cost),
+                          EdgeWeights<double>(this->_time), this->_dist, 0.0);
+    result.value = -ratio;
+    result.critical = traversal_order(cycle);
+    result.skew = this->_schedule(this->_cost, this->_time, ratio);
+    return result;
+}
+
+auto ClockSkewScheduler::max_slack(double period) -> ClockSkewResult {
+    auto result = ClockSkewResult{};
+    if (this->num_pairs() == 0) {
+        result.value = std::numeric_limits<double>::infinity();
+        result.skew.assign(this->num_registers(), 0.0);
+        return result;
+    }
+
+    // Every constraint loses the slack M, i.e. `cost = T - D - setup_time` or `d - hold_time`
+    // with `time = 1`. A pair alone allows at most the mean of its two costs.
+    auto cost = std::vector<double>(this->_cost.size());
+    const auto time = std::vector<double>(this->_cost.size(), 1.0);
+    auto bound = std::numeric_limits<double>::infinity();
+    for (size_t pair = 0; pair != this->num_pairs(); ++pair) {
+        cost[2 * pair] = period + this->_cost[2 * pair];
+        cost[2 * pair + 1] = this->_cost[2 * pair + 1];
+        bound = std::min(bound, (cost[2 * pair] + cost[2 * pair + 1]) / 2.0);
+    }
+    auto ratio = bound + 1.0;
+    const auto cycle = min_cycle_ratio(this->_csr, ratio, EdgeWeights<double>(cost),
+                                       EdgeWeights<double>(time), this->_dist, 0.0);
+    result.value = ratio;
+    result.critical = traversal_order(cycle);
+    result.skew = this->_schedule(cost, time, ratio);
+    return result;
+}
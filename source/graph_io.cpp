@@ -0,0 +1,289 @@
+#include <fmt/format.h>
+
+#include <algorithm>  // for max, min
+#include <array>
+#include <charconv>   // for from_chars
+#include <digraphx/graph_io.hpp>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>  // for runtime_error, invalid_argument
+
+using namespace digraphx;
+
+namespace {
+
+    constexpr auto binary_magic = std::array<char, 4>{'D', 'G', 'X', '1'};
+    constexpr uint32_t binary_has_time = 1U;
+
+    /**
+     * @brief Splits one line of a text graph file into numeric fields
+     */
+    class LineParser {
+        std::string_view _rest;
+        size_t _lineno;
+
+      public:
+        LineParser(std::string_view line, size_t lineno) : _rest{line}, _lineno{lineno} {}
+
+        /** Skips blanks and returns true if more fields are left. */
+        auto more() -> bool {
+            const auto pos = this->_rest.find_first_not_of(" \t\r");
+            this->_rest.remove_prefix(pos == std::string_view::npos ? this->_rest.size() : pos);
+            return !this->_rest.empty();
+        }
+
+        template <typename T> auto next(const char *what) -> T {
+            if (!this->more()) {
+                throw std::runtime_error(fmt::format("line {}: missing {}", this->_lineno, what));
+            }
+            auto value = T{};
+            const auto *first = this->_rest.data();
+            const auto *last = first + this->_rest.size();
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc{} || (ptr != last && *ptr != ' ' && *ptr != '\t' && *ptr != '\r')) {
+                throw std::runtime_error(fmt::format("line {}: invalid {}", this->_lineno, what));
+            }
+            this->_rest.remove_prefix(size_t(ptr - first));
+            return value;
+        }
+
+        auto word() -> std::string_view {
+            this->more();
+            const auto len = std::min(this->_rest.find_first_of(" \t\r"), this->_rest.size());
+            const auto result = this->_rest.substr(0, len);
+            this->_rest.remove_prefix(len);
+            return result;
+        }
+    };
+
+    void push_edge(GraphData &gra, LineParser &fields, uint32_t base, size_t lineno) {
+        const auto utx = fields.next<uint64_t>("source node");
+        const auto vtx = fields.next<uint64_t>("target node");
+        // node ids stop below UINT32_MAX so that the node count fits in a `uint32_t`
+        if (utx < base || vtx < base || utx - base >= UINT32_MAX || vtx - base >= UINT32_MAX) {
+            throw std::runtime_error(fmt::format("line {}: node id out of range", lineno));
+        }
+        gra.source.push_back(static_cast<uint32_t>(utx - base));
+        gra.target.push_back(static_cast<uint32_t>(vtx - base));
+        gra.cost.push_back(fields.next<double>("cost"));
+        const auto with_time = fields.more();
+        if (with_time != (gra.source.size() == 1 ? with_time : gra.has_time())) {
+            throw std::runtime_error(
+                fmt::format("line {}: either all or no edges must have a time", lineno));
+        }
+        if (with_time) {
+            gra.time.push_back(fields.next<double>("time"));
+        }
+        if (fields.more()) {
+            throw std::runtime_error(fmt::format("line {}: trailing fields", lineno));
+        }
+    }
+
+    auto read_dimacs(std::istream &input) -> GraphData {
+        auto gra = GraphData{};
+        auto line = std::string{};
+        auto num_edges = size_t{0};
+        auto has_header = false;
+        for (size_t lineno = 1; std::getline(input, line); ++lineno) {
+            auto fields = LineParser{line, lineno};
+            const auto kind = fields.word();
+            if (kind.empty() || kind == "c") {
+                continue;
+            }
+            if (kind == "p") {
+                if (has_header) {
+                    throw std::runtime_error(fmt::format("line {}: duplicate 'p' line", lineno));
+                }
+                fields.word();  // problem type, e.g. "sp"
+                gra.num_nodes = fields.next<size_t>("node count");
+                if (gra.num_nodes > UINT32_MAX) {
+                    throw std::runtime_error(fmt::format("line {}: too many nodes", lineno));
+                }
+                num_edges = fields.next<size_t>("edge count");
+                has_header = true;
+            } else if (kind == "a") {
+                if (!has_header) {
+                    throw std::runtime_error(fmt::format("line {}: 'a' before 'p' line", lineno));
+                }
+                push_edge(gra, fields, 1, lineno);
+                if (gra.source.back() >= gra.num_nodes || gra.target.back() >= gra.num_nodes) {
+                    throw std::runtime_error(fmt::format("line {}: node id out of range", lineno));
+                }
+            } else {
+                throw std::runtime_error(
+                    fmt::format("line {}: unknown line type '{}'", lineno, kind));
+            }
+        }
+        if (!has_header) {
+            throw std::runtime_error("missing 'p' line");
+        }
+        if (gra.num_edges() != num_edges) {
+            throw std::runtime_error(
+                fmt::format("expected {} arcs but found {}", num_edges, gra.num_edges()));
+        }
+        return gra;
+    }
+
+    auto read_edge_list(std::istream &input) -> GraphData {
+        auto gra = GraphData{};
+        auto line = std::string{};
+        for (size_t lineno = 1; std::getline(input, line); ++lineno) {
+            auto fields = LineParser{line, lineno};
+            if (!fields.more() || line[line.find_first_not_of(" \t")] == '#') {
+                continue;
+            }
+            push_edge(gra, fields, 0, lineno);
+            gra.num_nodes = std::max({gra.num_nodes, size_t(gra.source.back()) + 1,
+                                      size_t(gra.target.back()) + 1});
+        }
+        return gra;
+    }
+
+    /**
+     * Reads `len` items in chunks, so that a header claiming more items than the input holds
+     * fails at the end of the input instead of allocating for all of them up front.
+     */
+    template <typename T> void read_array(std::istream &input, std::vector<T> &arr, size_t len) {
+        constexpr auto chunk = size_t{1} << 16U;
+        arr.clear();
+        while (arr.size() != len) {
+            const auto done = arr.size();
+            arr.resize(done + std::min(chunk, len - done));
+            input.read(reinterpret_cast<char *>(arr.data() + done),
+                       std::streamsize((arr.size() - done) * sizeof(T)));
+            if (!input) {
+                throw std::runtime_error("truncated binary graph");
+            }
+        }
+    }
+
+    template <typename T> void read_scalar(std::istream &input, T &value) {
+        input.read(reinterpret_cast<char *>(&value), sizeof(T));
+        if (!input) {
+            throw std::runtime_error("truncated binary graph header");
+        }
+    }
+
+    auto read_binary(std::istream &input) -> GraphData {
+        auto magic = std::array<char, 4>{};
+        input.read(magic.data(), magic.size());
+        if (!input || magic != binary_magic) {
+            throw std::runtime_error("not a binary DiGraphX graph");
+        }
+        auto flags = uint32_t{0};
+        auto num_nodes = uint64_t{0};
+        auto num_edges = uint64_t{0};
+        read_scalar(input, flags);
+        read_scalar(input, num_nodes);
+        read_scalar(input, num_edges);
+        if (num_nodes > UINT32_MAX || num_edges > UINT32_MAX) {
+            throw std::runtime_error("binary graph too large");
+        }
+        auto gra = GraphData{};
+        gra.num_nodes = size_t(num_nodes);
+        read_array(input, gra.source, size_t(num_edges));
+        read_array(input, gra.target, size_t(num_edges));
+        read_array(input, gra.cost, size_t(num_edges));
+        if ((flags & binary_has_time) != 0U) {
+            read_array(input, gra.time, size_t(num_edges));
+        }
+        for (size_t i = 0; i != gra.num_edges(); ++i) {
+            if (gra.source[i] >= num_nodes || gra.target[i] >= num_nodes) {
+                throw std::runtime_error(fmt::format("edge {}: node id out of range", i));
+            }
+        }
+        return gra;
+    }
+
+    template <typename T> void write_array(std::ostream &output, const std::vector<T> &arr) {
+        output.write(reinterpret_cast<const char *>(arr.data()),
+                     std::streamsize(arr.size() * sizeof(T)));
+    }
+
+    template <typename T> void write_scalar(std::ostream &output, const T &value) {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+}  // namespace
+
+auto digraphx::parse_graph_format(std::string_view name) -> GraphFormat {
+    if (name == "dimacs") {
+        return GraphFormat::Dimacs;
+    }
+    if (name == "edgelist") {
+        return GraphFormat::EdgeList;
+    }
+    if (name == "binary") {
+        return GraphFormat::Binary;
+    }
+    throw std::invalid_argument(fmt::format("unknown graph format '{}'", name));
+}
+
+auto digraphx::guess_graph_format(std::string_view path) -> GraphFormat {
+    const auto ends_with = [path](std::string_view ext) { return path.ends_with(ext); };
+    if (ends_with(".dimacs") || ends_with(".gr") || ends_with(".max")) {
+        return GraphFormat::Dimacs;
+    }
+    if (ends_with(".bin") || ends_with(".dgx")) {
+        return GraphFormat::Binary;
+    }
+    return GraphFormat::EdgeList;
+}
+
+/**
+ * The function reads a graph in the given format from `input`. Text formats are
+ * parsed line by line, and every error message carries the offending line number.
+ */
+auto digraphx::read_graph(std::istream &input, GraphFormat format) -> GraphData {
+    switch (format) {
+        case GraphFormat::Dimacs:
+            return read_dimacs(input);
+        case GraphFormat::Binary:
+            return read_binary(input);
+        default:
+        case GraphFormat::EdgeList:
+            return read_edge_list(input);
+    }
+}
+
+auto digraphx::read_graph_file(const std::string &path, GraphFormat format) -> GraphData {
+    auto input = std::ifstream(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error(fmt::format("cannot open '{}'", path));
+    }
+    try {
+        return read_graph(input, format);
+    } catch (const std::runtime_error &err) {
+        throw std::runtime_error(fmt::format("{}: {}", path, err.what()));
+    }
+}
+
+void digraphx::write_graph(std::ostream &output, const GraphData &gra, GraphFormat format) {
+    if (format == GraphFormat::Binary) {
+        output.write(binary_magic.data(), binary_magic.size());
+        write_scalar(output, gra.has_time() ? binary_has_time : uint32_t{0});
+        write_scalar(output, uint64_t(gra.num_nodes));
+        write_scalar(output, uint64_t(gra.num_edges()));
+        write_array(output, gra.source);
+        write_array(output, gra.target);
+        write_array(output, gra.cost);
+        if (gra.has_time()) {
+            write_array(output, gra.time);
+        }
+        return;
+    }
+    const auto base = format == GraphFormat::Dimacs ? 1U : 0U;
+    const auto *prefix = format == GraphFormat::Dimacs ? "a " : "";
+    if (format == GraphFormat::Dimacs) {
+        output << fmt::format("p sp {} {}\n", gra.num_nodes, gra.num_edges());
+    }
+    for (size_t i = 0; i != gra.num_edges(); ++i) {
+        output << fmt::format("{}{} {} {}", prefix, gra.source[i] + base, gra.target[i] + base,
+                              gra.cost[i]);
+        if (gra.has_time()) {
+            output << fmt::format(" {}", gra.time[i]);
+        }
+        output << '\n';
+    }
+}
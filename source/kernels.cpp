@@ -0,0 +1,274 @@
+#include <fmt/format.h>
+
+#include <atomic>
+#include <cstdlib>  // for getenv
+#include <digraphx/kernels.hpp>
+#include <stdexcept>  // for invalid_argument
+
+// Every variant must round like the generic one, so a multiply followed by an
+// add is never fused into an FMA instruction (AVX-512 implies FMA).
+#if defined(__clang__)
+#    pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#    pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define DIGRAPHX_ISA_DISPATCH
+#    define DIGRAPHX_INLINE __attribute__((always_inline)) inline
+#    define DIGRAPHX_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#    define DIGRAPHX_TARGET_AVX512 \
+        __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,avx2,bmi,bmi2,popcnt")))
+#else
+#    define DIGRAPHX_INLINE inline
+#endif
+
+using namespace digraphx;
+
+namespace {
+
+    using Pred = std::pair<uint32_t, uint32_t>;
+
+    template <typename T> struct RelaxArgs {
+        std::span<const uint32_t> offsets;
+        std::span<const uint32_t> targets;
+        std::span<const uint32_t> edge_ids;
+        std::span<const T> weight;
+        std::span<T> dist;
+        std::span<Pred> pred;
+        std::span<uint8_t> has_pred;
+    };
+
+    template <typename T> struct WeightArgs {
+        std::span<const T> cost;
+        std::span<const T> time;
+        T ratio;
+        std::span<T> weight;
+    };
+
+    template <typename T> struct SumArgs {
+        std::span<const uint32_t> cycle;
+        std::span<const T> cost;
+        std::span<const T> time;
+    };
+
+    // The kernel bodies are written once and inlined into one wrapper per
+    // instruction set level, which the compiler then optimizes for that level.
+
+    template <typename T> DIGRAPHX_INLINE auto relax_body(const RelaxArgs<T> &args) -> bool {
+        const auto *offsets = args.offsets.data();
+        const auto *targets = args.targets.data();
+        const auto *edge_ids = args.edge_ids.data();
+        const auto *weight = args.weight.data();
+        auto *dist = args.dist.data();
+        auto *pred = args.pred.data();
+        auto *has_pred = args.has_pred.data();
+        const auto num_nodes = static_cast<uint32_t>(args.offsets.size() - 1);
+        auto changed = false;
+        for (auto utx = uint32_t{0}; utx != num_nodes; ++utx) {
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = targets[pos];
+                const auto edge = edge_ids[pos];
+                const auto distance = dist[utx] + weight[edge];
+                if (dist[vtx] > distance) {
+                    dist[vtx] = distance;
+                    pred[vtx] = Pred{utx, edge};
+                    has_pred[vtx] = 1;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    template <typename T> DIGRAPHX_INLINE void weights_body(const WeightArgs<T> &args) {
+        const auto *__restrict cost = args.cost.data();
+        const auto *__restrict time = args.time.data();
+        auto *__restrict weight = args.weight.data();
+        const auto ratio = args.ratio;
+        const auto num_edges = args.weight.size();
+        for (size_t i = 0; i != num_edges; ++i) {
+            weight[i] = cost[i] - ratio * time[i];
+        }
+    }
+
+    template <typename T> DIGRAPHX_INLINE auto sums_body(const SumArgs<T> &args)
+        -> std::pair<T, T> {
+        auto total_cost = T(0);
+        auto total_time = T(0);
+        for (const auto edge : args.cycle) {
+            total_cost += args.cost[edge];
+            total_time += args.time[edge];
+        }
+        return {total_cost, total_time};
+    }
+
+    template <typename T> auto relax_generic(const RelaxArgs<T> &args) -> bool {
+        return relax_body(args);
+    }
+    template <typename T> void weights_generic(const WeightArgs<T> &args) { weights_body(args); }
+    template <typename T> auto sums_generic(const SumArgs<T> &args) -> std::pair<T, T> {
+        return sums_body(args);
+    }
+
+#ifdef DIGRAPHX_ISA_DISPATCH
+    template <typename T> DIGRAPHX_TARGET_AVX2 auto relax_avx2(const RelaxArgs<T> &args) -> bool {
+        return relax_body(args);
+    }
+    template <typename T> DIGRAPHX_TARGET_AVX2 void weights_avx2(const WeightArgs<T> &args) {
+        weights_body(args);
+    }
+    template <typename T> DIGRAPHX_TARGET_AVX2 auto sums_avx2(const SumArgs<T> &args)
+        -> std::pair<T, T> {
+        return sums_body(args);
+    }
+
+    template <typename T> DIGRAPHX_TARGET_AVX512 auto relax_avx512(const RelaxArgs<T> &args)
+        -> bool {
+        return relax_body(args);
+    }
+    template <typename T> DIGRAPHX_TARGET_AVX512 void weights_avx512(const WeightArgs<T> &args) {
+        weights_body(args);
+    }
+    template <typename T> DIGRAPHX_TARGET_AVX512 auto sums_avx512(const SumArgs<T> &args)
+        -> std::pair<T, T> {
+        return sums_body(args);
+    }
+#endif
+
+    /** Caps `isa` at the detected level. */
+    auto supported(Isa isa) -> Isa {
+        const auto best = detected_isa();
+        return static_cast<int>(isa) > static_cast<int>(best) ? best : isa;
+    }
+
+    auto initial_isa() -> Isa {
+        const auto *name = std::getenv("DIGRAPHX_ISA");
+        if (name == nullptr) {
+            return detected_isa();
+        }
+        try {
+            return supported(parse_isa(name));
+        } catch (const std::invalid_argument &) {
+            return detected_isa();  // an unknown name is ignored
+        }
+    }
+
+    auto isa_slot() -> std::atomic<Isa> & {
+        static auto slot = std::atomic<Isa>{initial_isa()};
+        return slot;
+    }
+
+    template <typename T> auto relax_dispatch(const RelaxArgs<T> &args) -> bool {
+        switch (isa_slot().load(std::memory_order_relaxed)) {
+#ifdef DIGRAPHX_ISA_DISPATCH
+            case Isa::Avx512:
+                return relax_avx512(args);
+            case Isa::Avx2:
+                return relax_avx2(args);
+#endif
+            default:
+                return relax_generic(args);
+        }
+    }
+
+    template <typename T> void weights_dispatch(const WeightArgs<T> &args) {
+        switch (isa_slot().load(std::memory_order_relaxed)) {
+#ifdef DIGRAPHX_ISA_DISPATCH
+            case Isa::Avx512:
+                return weights_avx512(args);
+            case Isa::Avx2:
+                return weights_avx2(args);
+#endif
+            default:
+                return weights_generic(args);
+        }
+    }
+
+    template <typename T> auto sums_dispatch(const SumArgs<T> &args) -> std::pair<T, T> {
+        switch (isa_slot().load(std::memory_order_relaxed)) {
+#ifdef DIGRAPHX_ISA_DISPATCH
+            case Isa::Avx512:
+                return sums_avx512(args);
+            case Isa::Avx2:
+                return sums_avx2(args);
+#endif
+            default:
+                return sums_generic(args);
+        }
+    }
+
+}  // namespace
+
+auto digraphx::parse_isa(std::string_view name) -> Isa {
+    if (name == "generic") {
+        return Isa::Generic;
+    }
+    if (name == "avx2") {
+        return Isa::Avx2;
+    }
+    if (name == "avx512") {
+        return Isa::Avx512;
+    }
+    throw std::invalid_argument(fmt::format("unknown instruction set '{}'", name));
+}
+
+auto digraphx::to_string(Isa isa) -> std::string_view {
+    switch (isa) {
+        case Isa::Avx2:
+            return "avx2";
+        case Isa::Avx512:
+            return "avx512";
+        default:
+        case Isa::Generic:
+            return "generic";
+    }
+}
+
+auto digraphx::detected_isa() -> Isa {
+#ifdef DIGRAPHX_ISA_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")
+        && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq")) {
+        return Isa::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) {
+        return Isa::Avx2;
+    }
+#endif
+    return Isa::Generic;
+}
+
+auto digraphx::active_isa() -> Isa { return isa_slot().load(); }
+
+auto digraphx::select_isa(Isa isa) -> Isa {
+    const auto level = supported(isa);
+    isa_slot().store(level);
+    return level;
+}
+
+#define DIGRAPHX_DEFINE_RELAX(T)                                                              \
+    auto digraphx::relax_csr(std::span<const uint32_t> offsets,                               \
+                             std::span<const uint32_t> targets,                               \
+                             std::span<const uint32_t> edge_ids, std::span<const T> weight,   \
+                             std::span<T> dist, std::span<Pred> pred,                         \
+                             std::span<uint8_t> has_pred) -> bool {                           \
+        return relax_dispatch(                                                                \
+            RelaxArgs<T>{offsets, targets, edge_ids, weight, dist, pred, has_pred});          \
+    }
+DIGRAPHX_DEFINE_RELAX(int32_t)
+DIGRAPHX_DEFINE_RELAX(int64_t)
+DIGRAPHX_DEFINE_RELAX(float)
+DIGRAPHX_DEFINE_RELAX(double)
+
+#define DIGRAPHX_DEFINE_FLOAT_KERNELS(T)                                                      \
+    void digraphx::parametric_weights(std::span<const T> cost, std::span<const T> time,       \
+                                      T ratio, std::span<T> weight) {                         \
+        weights_dispatch(WeightArgs<T>{cost, time, ratio, weight});                           \
+    }                                                                                         \
+    auto digraphx::cycle_sums(std::span<const uint32_t> cycle, std::span<const T> cost,       \
+                              std::span<const T> time) -> std::pair<T, T> {                   \
+        return sums_dispatch(SumArgs<T>{cycle, cost, time});                                  \
+    }
+DIGRAPHX_DEFINE_FLOAT_KERNELS(float)
+DIGRAPHX_DEFINE_FLOAT_KERNELS(double)
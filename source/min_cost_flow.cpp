@@ -0,0 +1,270 @@
+#include <algorithm>  // for any_of, fill, max, min
+#include <deque>
+#include <digraphx/min_cost_flow.hpp>
+#include <digraphx/min_cycle_ratio.hpp>
+#include <limits>
+#include <numeric>    // for accumulate
+#include <stdexcept>  // for invalid_argument, logic_error
+
+using namespace digraphx;
+
+namespace {
+
+    /**
+     * @brief The network extended by a hub node, as residual arc arrays
+     *
+     * Network arc `e` is arc `e` here, and node `v` gets the artificial arcs
+     * `m + v` (v -> hub) and `m + n + v` (hub -> v). Arc `a` has the residual
+     * arcs `2 a` and `2 a + 1`; the residual capacity of the backward one is
+     * the flow on `a`.
+     */
+    struct ResidualNetwork {
+        size_t num_nodes{0};  // without the hub
+        size_t num_arcs{0};   // network arcs, without the artificial ones
+        std::vector<uint32_t> tail{};
+        std::vector<uint32_t> head{};
+        std::vector<int64_t> cost{};
+        std::vector<int64_t> residual{};
+    };
+
+    auto make_residual(size_t num_nodes, std::span<const uint32_t> from,
+                       std::span<const uint32_t> to, std::span<const int64_t> capacity,
+                       std::span<const int64_t> cost) -> ResidualNetwork {
+        if (to.size() != from.size() || capacity.size() != from.size()
+            || cost.size() != from.size()) {
+            throw std::invalid_argument("MinCostFlow: array sizes differ");
+        }
+        if (std::any_of(capacity.begin(), capacity.end(), [](int64_t cap) { return cap < 0; })) {
+            throw std::invalid_argument("MinCostFlow: negative capacity");
+        }
+        const auto hub = uint32_t(num_nodes);
+        auto net = ResidualNetwork{};
+        net.num_nodes = num_nodes;
+        net.num_arcs = from.size();
+        const auto num_total = 2 * (from.size() + 2 * num_nodes);
+        net.tail.reserve(num_total);
+        net.head.reserve(num_total);
+        net.cost.reserve(num_total);
+        net.residual.assign(num_total, 0);
+        auto add_arc = [&net](uint32_t utx, uint32_t vtx, int64_t weight) {
+            net.tail.push_back(utx);
+            net.head.push_back(vtx);
+            net.cost.push_back(weight);
+            net.tail.push_back(vtx);
+            net.head.push_back(utx);
+            net.cost.push_back(-weight);
+        };
+
+        auto max_cost = int64_t{0};
+        for (size_t i = 0; i != from.size(); ++i) {
+            if (from[i] >= num_nodes || to[i] >= num_nodes) {
+                throw std::invalid_argument("MinCostFlow: node index out of range");
+            }
+            add_arc(from[i], to[i], cost[i]);
+            net.residual[2 * i] = capacity[i];
+            max_cost = std::max(max_cost, cost[i] < 0 ? -cost[i] : cost[i]);
+        }
+        // dearer than any simple path of the network
+        const auto big = 1 + int64_t(num_nodes) * max_cost;
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            add_arc(vtx, hub, big);
+        }
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            add_arc(hub, vtx, big);
+        }
+        return net;
+    }
+
+    /** Routes the supplies over the artificial arcs, with no flow on the network arcs. */
+    void check_supply(size_t num_nodes, std::span<const int64_t> supply) {
+        if (supply.size() != num_nodes) {
+            throw std::invalid_argument("MinCostFlow: supply size differs from the node count");
+        }
+        if (std::accumulate(supply.begin(), supply.end(), int64_t{0}) != 0) {
+            throw std::invalid_argument("MinCostFlow: supplies do not sum to zero");
+        }
+    }
+
+    void load_supply(ResidualNetwork &net, std::span<const int64_t> supply) {
+        check_supply(net.num_nodes, supply);
+        for (size_t i = 0; i != net.num_arcs; ++i) {
+            net.residual[2 * i] += net.residual[2 * i + 1];
+            net.residual[2 * i + 1] = 0;
+        }
+        for (size_t vtx = 0; vtx != net.num_nodes; ++vtx) {
+            const auto out = 2 * (net.num_arcs + vtx);                  // v -> hub
+            const auto in = 2 * (net.num_arcs + net.num_nodes + vtx);  // hub -> v
+            net.residual[out] = 0;
+            net.residual[out + 1] = std::max(supply[vtx], int64_t{0});
+            net.residual[in] = 0;
+            net.residual[in + 1] = std::max(-supply[vtx], int64_t{0});
+        }
+    }
+
+    auto make_result(const ResidualNetwork &net, std::span<const int64_t> cost, size_t iterations)
+        -> MinCostFlowResult {
+        auto result = MinCostFlowResult{};
+        result.iterations = iterations;
+        result.flow.resize(net.num_arcs);
+        for (size_t i = 0; i != net.num_arcs; ++i) {
+            result.flow[i] = net.residual[2 * i + 1];
+            result.cost += cost[i] * result.flow[i];
+        }
+        result.feasible = true;
+        for (auto arc = 2 * net.num_arcs + 1; arc < net.residual.size(); arc += 2) {
+            result.feasible = result.feasible && net.residual[arc] == 0;
+        }
+        return result;
+    }
+
+}  // namespace
+
+MinCostFlow::MinCostFlow(size_t num_nodes, std::span<const uint32_t> from,
+                         std::span<const uint32_t> to, std::span<const int64_t> capacity,
+                         std::span<const int64_t> cost)
+    : _num_nodes{num_nodes}, _num_arcs{from.size()} {
+    auto net = make_residual(num_nodes, from, to, capacity, cost);
+    this->_cost = std::move(net.cost);
+    this->_residual = std::move(net.residual);
+    this->_csr.assign(num_nodes + 1, net.tail, net.head);
+    this->_weight.resize(this->_cost.size());
+    this->_time.assign(this->_cost.size(), 1.0);
+    this->_dist.assign(num_nodes + 1, 0.0);
+}
+
+auto MinCostFlow::solve(std::span<const int64_t> supply) -> MinCostFlowResult {
+    check_supply(this->_num_nodes, supply);  // before the residual network is taken over
+    auto net = ResidualNetwork{};
+    net.num_nodes = this->_num_nodes;
+    net.num_arcs = this->_num_arcs;
+    net.residual = std::move(this->_residual);
+    load_supply(net, supply);
+    auto &residual = net.residual;
+
+    const auto inf = std::numeric_limits<double>::infinity();
+    auto update_weight = [&](size_t arc) {
+        this->_weight[arc] = residual[arc] > 0 ? double(this->_cost[arc]) : inf;
+    };
+    for (size_t arc = 0; arc != residual.size(); ++arc) {
+        update_weight(arc);
+    }
+
+    auto iterations = size_t{0};
+    while (true) {
+        auto mean = 0.0;
+        const auto cycle = min_cycle_ratio(this->_csr, mean, EdgeWeights<double>(this->_weight),
+                                           EdgeWeights<double>(this->_time), this->_dist, 0.0);
+        if (cycle.empty()) {
+            break;
+        }
+        auto delta = std::numeric_limits<int64_t>::max();
+        for (const auto arc : cycle) {
+            delta = std::min(delta, residual[arc]);
+        }
+        for (const auto arc : cycle) {
+            residual[arc] -= delta;
+            residual[arc ^ 1U] += delta;
+            update_weight(arc);
+            update_weight(arc ^ 1U);
+        }
+        ++iterations;
+    }
+
+    auto network_cost = std::vector<int64_t>(this->_num_arcs);
+    for (size_t i = 0; i != this->_num_arcs; ++i) {
+        network_cost[i] = this->_cost[2 * i];
+    }
+    auto result = make_result(net, network_cost, iterations);
+    this->_residual = std::move(net.residual);
+    return result;
+}
+
+auto digraphx::min_cost_flow_cost_scaling(size_t num_nodes, std::span<const uint32_t> from,
+                                          std::span<const uint32_t> to,
+                                          std::span<const int64_t> capacity,
+                                          std::span<const int64_t> cost,
+                                          std::span<const int64_t> supply) -> MinCostFlowResult {
+    constexpr auto alpha = int64_t{16};
+
+    auto net = make_residual(num_nodes, from, to, capacity, cost);
+    load_supply(net, supply);
+    const auto num_all = num_nodes + 1;
+    auto csr = CsrGraph(num_all, net.tail, net.head);
+    const auto offsets = csr.offsets();
+    const auto arcs = csr.edge_ids();
+    auto &residual = net.residual;
+
+    // with the costs scaled by the node count, a 1-optimal flow is optimal
+    auto scaled = std::vector<int64_t>(net.cost.size());
+    auto epsilon = int64_t{1};
+    for (size_t arc = 0; arc != scaled.size(); ++arc) {
+        scaled[arc] = net.cost[arc] * int64_t(num_all);
+        epsilon = std::max(epsilon, scaled[arc]);
+    }
+    auto price = std::vector<int64_t>(num_all, 0);
+    auto excess = std::vector<int64_t>(num_all, 0);
+    auto current = std::vector<uint32_t>(num_all);
+    auto active = std::deque<uint32_t>{};
+    auto reduced = [&](size_t arc) {
+        return scaled[arc] + price[net.tail[arc]] - price[net.head[arc]];
+    };
+    auto push = [&](size_t arc, int64_t amount) {
+        residual[arc] -= amount;
+        residual[arc ^ 1U] += amount;
+        excess[net.tail[arc]] -= amount;
+        const auto vtx = net.head[arc];
+        if (excess[vtx] <= 0 && excess[vtx] + amount > 0) {
+            active.push_back(vtx);
+        }
+        excess[vtx] += amount;
+    };
+
+    auto phases = size_t{0};
+    do {
+        epsilon = std::max(epsilon / alpha, int64_t{1});
+        ++phases;
+
+        // saturating every arc of negative reduced cost leaves a 0-optimal pseudoflow
+        for (size_t arc = 0; arc != residual.size(); ++arc) {
+            if (residual[arc] > 0 && reduced(arc) < 0) {
+                push(arc, residual[arc]);
+            }
+        }
+        std::copy(offsets.begin(), offsets.end() - 1, current.begin());
+
+        while (!active.empty()) {
+            const auto utx = active.front();
+            active.pop_front();
+            while (excess[utx] > 0) {
+                auto &pos = current[utx];
+                for (; pos != offsets[utx + 1]; ++pos) {
+                    const auto arc = arcs[pos];
+                    if (residual[arc] > 0 && reduced(arc) < 0) {
+                        push(arc, std::min(excess[utx], residual[arc]));
+                        if (excess[utx] == 0) {
+                            break;  // the arc may stay admissible
+                        }
+                    }
+                }
+                if (excess[utx] == 0) {
+                    break;
+                }
+                // relabel: lower the price until some residual arc becomes admissible
+                auto highest = std::numeric_limits<int64_t>::min();
+                for (auto i = offsets[utx]; i != offsets[utx + 1]; ++i) {
+                    const auto arc = arcs[i];
+                    if (residual[arc] > 0) {
+                        highest = std::max(highest, price[net.head[arc]] - scaled[arc]);
+                    }
+                }
+                if (highest == std::numeric_limits<int64_t>::min()) {
+                    throw std::logic_error("min_cost_flow_cost_scaling: excess with no way out");
+                }
+                price[utx] = highest - epsilon;
+                pos = offsets[utx];
+            }
+        }
+    } while (epsilon > 1);
+
+    return make_result(net, cost, phases);
+}
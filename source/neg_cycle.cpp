@@ -0,0 +1,20 @@
+// Precompiled solver instances for `CsrGraph`; see `DIGRAPHX_CSR_DOMAINS`.
+#ifndef DIGRAPHX_HEADER_ONLY
+#    define DIGRAPHX_HEADER_ONLY  // this file provides the instances declared extern
+#endif
+
+#include <cppcoro/generator.hpp>
+#include <cstdint>  // for int32_t, int64_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/min_cycle_ratio.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <vector>
+
+#define DIGRAPHX_DEFINE_HOWARD(T) DIGRAPHX_HOWARD_INSTANCE(template, T)
+DIGRAPHX_CSR_DOMAINS(DIGRAPHX_DEFINE_HOWARD)
+
+#define DIGRAPHX_DEFINE_MIN_CYCLE_RATIO(T)                                 \
+    DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(template, T, EdgeWeights<T>)         \
+    DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(template, T, EdgeWeights<T> &)       \
+    DIGRAPHX_MIN_CYCLE_RATIO_INSTANCE(template, T, const EdgeWeights<T> &)
+DIGRAPHX_CSR_DOMAINS(DIGRAPHX_DEFINE_MIN_CYCLE_RATIO)
@@ -1,2 +0,0 @@
-#include <digraphx/neg_cycle.hpp>
-#include <cppcoro/generator.hpp>
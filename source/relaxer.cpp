@@ -0,0 +1,881 @@
+#include <fmt/format.h>
+
+#include <algorithm>  // for fill, lower_bound, max, min, nth_element, remove_if
+#include <atomic>     // for atomic, atomic_ref
+#include <cmath>      // for ceil
+#include <concepts>   // for integral
+#include <deque>
+#include <digraphx/relaxer.hpp>
+#include <limits>
+#include <memory>  // for unique_ptr
+#include <mutex>
+#include <stdexcept>  // for invalid_argument
+#include <thread>
+
+using namespace digraphx;
+
+auto digraphx::parse_relax_mode(std::string_view name) -> RelaxMode {
+    if (name == "sweep") {
+        return RelaxMode::Sweep;
+    }
+    if (name == "pushpull") {
+        return RelaxMode::PushPull;
+    }
+    if (name == "blocked") {
+        return RelaxMode::Blocked;
+    }
+    if (name == "async") {
+        return RelaxMode::Async;
+    }
+    if (name == "delta") {
+        return RelaxMode::Delta;
+    }
+    if (name == "deque") {
+        return RelaxMode::Deque;
+    }
+    if (name == "threshold") {
+        return RelaxMode::Threshold;
+    }
+    if (name == "adaptive") {
+        return RelaxMode::Adaptive;
+    }
+    throw std::invalid_argument(fmt::format("unknown relaxation mode '{}'", name));
+}
+
+auto digraphx::to_string(RelaxMode mode) -> std::string_view {
+    switch (mode) {
+        case RelaxMode::PushPull:
+            return "pushpull";
+        case RelaxMode::Blocked:
+            return "blocked";
+        case RelaxMode::Async:
+            return "async";
+        case RelaxMode::Delta:
+            return "delta";
+        case RelaxMode::Deque:
+            return "deque";
+        case RelaxMode::Threshold:
+            return "threshold";
+        case RelaxMode::Adaptive:
+            return "adaptive";
+        case RelaxMode::Sweep:
+            break;
+    }
+    return "sweep";
+}
+
+void CsrRelaxer::set_options(RelaxOptions options) {
+    if (options.local_passes == 0) {
+        // `Blocked` would never relax an edge within a block and miss the cycles there
+        throw std::invalid_argument("RelaxOptions::local_passes must be at least 1");
+    }
+    this->_options = options;
+    this->_graph = nullptr;
+    this->_shared_in = nullptr;
+    this->_blocked_graph = nullptr;
+}
+
+CsrTranspose::CsrTranspose(const CsrGraph &gra) {
+    const auto num_nodes = gra.num_nodes();
+    const auto out_offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto out_edges = gra.edge_ids();
+
+    this->offsets.assign(num_nodes + 1, 0);
+    for (const auto vtx : targets) {
+        ++this->offsets[vtx + 1];
+    }
+    for (size_t vtx = 0; vtx != num_nodes; ++vtx) {
+        this->offsets[vtx + 1] += this->offsets[vtx];
+    }
+    this->sources.resize(targets.size());
+    this->edges.resize(targets.size());
+    auto fill = std::vector<uint32_t>(this->offsets.begin(), this->offsets.end() - 1);
+    for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+        for (auto pos = out_offsets[utx]; pos != out_offsets[utx + 1]; ++pos) {
+            const auto slot = fill[targets[pos]]++;
+            this->sources[slot] = utx;
+            this->edges[slot] = out_edges[pos];
+        }
+    }
+}
+
+/**
+ * The function takes the shared in-edge CSR of `gra` if the options carry one that fits, builds
+ * its own otherwise, and splits the nodes into one range per thread with about the same number
+ * of in-edges each.
+ */
+void CsrRelaxer::_transpose(const CsrGraph &gra) {
+    const auto *shared = this->_options.transpose;
+    this->_shared_in = shared != nullptr && shared->fits(gra) ? shared : nullptr;
+    if (this->_shared_in == nullptr) {
+        this->_own_in = CsrTranspose(gra);
+    }
+
+    const auto &in_offsets = this->_in().offsets;
+    const auto num_nodes = gra.num_nodes();
+    const auto threads = std::max<size_t>(1, this->_options.threads);
+    const auto num_edges = size_t(in_offsets.back());
+    this->_ranges.assign(threads + 1, uint32_t(num_nodes));
+    this->_ranges[0] = 0;
+    for (size_t i = 1; i != threads; ++i) {
+        const auto share = uint32_t(num_edges * i / threads);
+        const auto it = std::lower_bound(in_offsets.begin(), in_offsets.end() - 1, share);
+        this->_ranges[i]
+            = std::max(this->_ranges[i - 1], uint32_t(it - in_offsets.begin()));
+    }
+    this->_graph = &gra;
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::_push(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                       std::span<std::pair<uint32_t, uint32_t>> pred,
+                       std::span<uint8_t> has_pred) -> bool {
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    auto relax_from = [&](uint32_t utx) {
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            const auto vtx = targets[pos];
+            const auto distance = dist[utx] + weight[edges[pos]];
+            if (dist[vtx] > distance) {
+                dist[vtx] = distance;
+                pred[vtx] = {utx, edges[pos]};
+                has_pred[vtx] = 1;
+                if (this->_next_active[vtx] == 0) {
+                    this->_next_active[vtx] = 1;
+                    this->_next_list.push_back(vtx);
+                }
+            }
+        }
+    };
+    if (this->_all_active) {
+        for (uint32_t utx = 0; utx != gra.num_nodes(); ++utx) {
+            relax_from(utx);
+        }
+    } else if (double(this->_active_list.size())
+               >= this->_options.list_fraction * double(gra.num_nodes())) {
+        // Scanning in node order also relaxes from nodes lowered earlier in this pass, as a
+        // sweep does, which saves passes once many nodes are active.
+        for (uint32_t utx = 0; utx != gra.num_nodes(); ++utx) {
+            if (this->_active[utx] != 0 || this->_next_active[utx] != 0) {
+                relax_from(utx);
+            }
+        }
+    } else {
+        for (const auto utx : this->_active_list) {
+            relax_from(utx);
+        }
+    }
+    ++this->_push_passes;
+    return !this->_next_list.empty();
+}
+
+/**
+ * The function runs one `relax_csr` sweep and collects the nodes it lowered by comparing the
+ * distances with a copy taken before, which costs far less than the sweep over the edges.
+ */
+template <KernelDomain T>
+auto CsrRelaxer::_sweep(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                        std::span<std::pair<uint32_t, uint32_t>> pred,
+                        std::span<uint8_t> has_pred) -> bool {
+    const auto before = std::vector<T>(dist.begin(), dist.end());
+    const auto changed
+        = relax_csr(gra.offsets(), gra.targets(), gra.edge_ids(), weight, dist, pred, has_pred);
+    if (changed) {
+        for (uint32_t vtx = 0; vtx != gra.num_nodes(); ++vtx) {
+            if (dist[vtx] != before[vtx]) {
+                this->_next_active[vtx] = 1;
+                this->_next_list.push_back(vtx);
+            }
+        }
+    }
+    ++this->_sweep_passes;
+    return changed;
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::_pull(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                       std::span<std::pair<uint32_t, uint32_t>> pred,
+                       std::span<uint8_t> has_pred) -> bool {
+    if (this->_graph != &gra || !this->_in().fits(gra)) {
+        this->_transpose(gra);
+    }
+    const auto all_active = this->_all_active;
+    const auto &in_offsets = this->_in().offsets;
+    const auto &in_sources = this->_in().sources;
+    const auto &in_edges = this->_in().edges;
+    auto worker = [&, this](uint32_t first, uint32_t last) {
+        for (auto vtx = first; vtx != last; ++vtx) {
+            auto dist_v = std::atomic_ref<T>(dist[vtx]);
+            auto best = dist_v.load(std::memory_order_relaxed);
+            auto slot = in_offsets[vtx + 1];
+            for (auto pos = in_offsets[vtx]; pos != in_offsets[vtx + 1]; ++pos) {
+                const auto utx = in_sources[pos];
+                if (!all_active && this->_active[utx] == 0) {
+                    continue;
+                }
+                const auto distance = std::atomic_ref<T>(dist[utx]).load(std::memory_order_relaxed)
+                                      + weight[in_edges[pos]];
+                if (best > distance) {
+                    best = distance;
+                    slot = pos;
+                }
+            }
+            if (slot != in_offsets[vtx + 1]) {
+                dist_v.store(best, std::memory_order_relaxed);
+                pred[vtx] = {in_sources[slot], in_edges[slot]};
+                has_pred[vtx] = 1;
+                this->_next_active[vtx] = 1;
+            }
+        }
+    };
+
+    this->_team.run(this->_ranges.size() - 1,
+                    [&, this](size_t i) { worker(this->_ranges[i], this->_ranges[i + 1]); });
+
+    for (uint32_t vtx = 0; vtx != gra.num_nodes(); ++vtx) {
+        if (this->_next_active[vtx] != 0) {
+            this->_next_list.push_back(vtx);
+        }
+    }
+    ++this->_pull_passes;
+    return !this->_next_list.empty();
+}
+
+/**
+ * The function splits the out-edges of every node into the edges within its block of
+ * `block_size` consecutive nodes and the edges to other blocks.
+ */
+void CsrRelaxer::_split_blocks(const CsrGraph &gra, size_t block_size) {
+    const auto num_nodes = gra.num_nodes();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+
+    this->_intra_offsets.assign(1, 0);
+    this->_inter_offsets.assign(1, 0);
+    this->_intra_offsets.reserve(size_t(num_nodes) + 1);
+    this->_inter_offsets.reserve(size_t(num_nodes) + 1);
+    for (auto *part : {&this->_intra_targets, &this->_intra_edges, &this->_inter_targets,
+                       &this->_inter_edges}) {
+        part->clear();
+        part->reserve(targets.size());
+    }
+    for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+        const auto first = utx - utx % block_size;
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            const auto vtx = targets[pos];
+            if (vtx >= first && vtx - first < block_size) {
+                this->_intra_targets.push_back(vtx);
+                this->_intra_edges.push_back(edges[pos]);
+            } else {
+                this->_inter_targets.push_back(vtx);
+                this->_inter_edges.push_back(edges[pos]);
+            }
+        }
+        this->_intra_offsets.push_back(uint32_t(this->_intra_targets.size()));
+        this->_inter_offsets.push_back(uint32_t(this->_inter_targets.size()));
+    }
+    this->_block_size = block_size;
+    this->_blocked_graph = &gra;
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::_blocked(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                          std::span<std::pair<uint32_t, uint32_t>> pred,
+                          std::span<uint8_t> has_pred) -> bool {
+    const auto num_nodes = gra.num_nodes();
+    auto block_size = this->_options.block_size;
+    if (block_size == 0) {
+        // the distance, predecessor and flags of a node
+        block_size = std::max<size_t>(1024, (size_t{512} << 10U) / (sizeof(T) + 10));
+    }
+    if (this->_blocked_graph != &gra || this->_block_size != block_size
+        || this->_intra_offsets.size() != num_nodes + 1
+        || this->_intra_targets.size() + this->_inter_targets.size() != gra.targets().size()) {
+        this->_split_blocks(gra, block_size);
+    }
+    const auto num_blocks = (num_nodes + block_size - 1) / block_size;
+    if (this->_all_active) {
+        std::fill(this->_active.begin(), this->_active.end(), uint8_t{1});
+        this->_block_active.assign(num_blocks, 1);
+    }
+
+    auto &lowered = this->_active;
+    auto &touched = this->_next_active;
+    auto changed = false;
+    auto lower = [&](uint32_t utx, uint32_t vtx, uint32_t edge) -> bool {
+        const auto distance = dist[utx] + weight[edge];
+        if (dist[vtx] > distance) {
+            dist[vtx] = distance;
+            pred[vtx] = {utx, edge};
+            has_pred[vtx] = 1;
+            lowered[vtx] = 1;
+            changed = true;
+            return true;
+        }
+        return false;
+    };
+
+    for (size_t block = 0; block != num_blocks; ++block) {
+        if (this->_block_active[block] == 0) {
+            continue;
+        }
+        const auto first = uint32_t(block * block_size);
+        const auto last = uint32_t(std::min(num_nodes, (block + 1) * block_size));
+
+        auto again = true;
+        for (size_t local = 0; again && local != this->_options.local_passes; ++local) {
+            again = false;
+            for (auto utx = first; utx != last; ++utx) {
+                if (lowered[utx] == 0) {
+                    continue;
+                }
+                lowered[utx] = 0;
+                touched[utx] = 1;
+                for (auto pos = this->_intra_offsets[utx]; pos != this->_intra_offsets[utx + 1];
+                     ++pos) {
+                    again = lower(utx, this->_intra_targets[pos], this->_intra_edges[pos]) || again;
+                }
+            }
+            ++this->_local_passes;
+        }
+        this->_block_active[block] = again ? 1 : 0;  // unsettled nodes wait for the next pass
+
+        for (auto utx = first; utx != last; ++utx) {
+            if (touched[utx] == 0) {
+                continue;
+            }
+            touched[utx] = 0;
+            for (auto pos = this->_inter_offsets[utx]; pos != this->_inter_offsets[utx + 1];
+                 ++pos) {
+                const auto vtx = this->_inter_targets[pos];
+                if (lower(utx, vtx, this->_inter_edges[pos])) {
+                    this->_block_active[vtx / block_size] = 1;
+                }
+            }
+        }
+    }
+    ++this->_blocked_passes;
+    return changed;
+}
+
+namespace {
+    /** Queue of nodes owned by one async thread; other threads steal from its back */
+    struct WorkQueue {
+        std::mutex mutex{};
+        std::deque<uint32_t> nodes{};
+    };
+
+    /**
+     * The function lowers `dist[vtx]` to `distance` and sets its predecessor if that is an
+     * improvement, with other threads doing the same. The unlocked check skips the per-node
+     * spin lock for the edges that improve nothing, which are most of them.
+     */
+    template <typename T>
+    auto lower_locked(std::span<T> dist, std::span<std::pair<uint32_t, uint32_t>> pred,
+                      std::span<uint8_t> has_pred, std::span<uint8_t> locks, uint32_t utx,
+                      uint32_t vtx, uint32_t edge, T distance) -> bool {
+        auto dist_v = std::atomic_ref<T>(dist[vtx]);
+        if (!(dist_v.load(std::memory_order_relaxed) > distance)) {
+            return false;
+        }
+        auto lock = std::atomic_ref<uint8_t>(locks[vtx]);
+        while (lock.exchange(1, std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+        const auto improved = dist_v.load(std::memory_order_relaxed) > distance;
+        if (improved) {
+            dist_v.store(distance, std::memory_order_relaxed);
+            pred[vtx] = {utx, edge};
+            has_pred[vtx] = 1;
+        }
+        lock.store(0, std::memory_order_release);
+        return improved;
+    }
+}  // namespace
+
+template <KernelDomain T>
+auto CsrRelaxer::_async(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                        std::span<std::pair<uint32_t, uint32_t>> pred,
+                        std::span<uint8_t> has_pred) -> bool {
+    const auto num_nodes = gra.num_nodes();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    if (this->_locks.size() != num_nodes) {
+        this->_locks.assign(num_nodes, 0);
+    }
+    if (this->_all_active) {
+        this->_active_list.resize(num_nodes);
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            this->_active_list[vtx] = vtx;
+        }
+    }
+    if (this->_active_list.empty()) {
+        return false;
+    }
+
+    // `_active` flags the queued nodes; every thread starts on a contiguous share of them
+    const auto threads = std::max<size_t>(1, std::min(this->_options.threads,
+                                                      this->_active_list.size()));
+    auto queues = std::vector<std::unique_ptr<WorkQueue>>(threads);
+    for (size_t i = 0; i != threads; ++i) {
+        queues[i] = std::make_unique<WorkQueue>();
+        const auto first = this->_active_list.size() * i / threads;
+        const auto last = this->_active_list.size() * (i + 1) / threads;
+        for (auto idx = first; idx != last; ++idx) {
+            const auto vtx = this->_active_list[idx];
+            this->_active[vtx] = 1;
+            queues[i]->nodes.push_back(vtx);
+        }
+    }
+    auto pending = std::atomic<size_t>{this->_active_list.size()};  // queued or being relaxed
+    auto budget = std::atomic<int64_t>{
+        int64_t(std::max(1.0, this->_options.epoch_edges * double(targets.size())))};
+    auto stop = std::atomic<bool>{false};
+    auto changed = std::atomic<bool>{false};
+    auto steals = std::atomic<size_t>{0};
+
+    auto pop = [&](size_t self, uint32_t &utx) -> bool {
+        {
+            auto lock = std::lock_guard(queues[self]->mutex);
+            if (!queues[self]->nodes.empty()) {
+                utx = queues[self]->nodes.front();
+                queues[self]->nodes.pop_front();
+                return true;
+            }
+        }
+        for (size_t i = 1; i != threads; ++i) {
+            auto &victim = *queues[(self + i) % threads];
+            auto loot = std::vector<uint32_t>{};
+            {
+                auto lock = std::lock_guard(victim.mutex);
+                const auto half = (victim.nodes.size() + 1) / 2;
+                loot.assign(victim.nodes.end() - std::ptrdiff_t(half), victim.nodes.end());
+                victim.nodes.resize(victim.nodes.size() - half);
+            }
+            if (!loot.empty()) {
+                ++steals;
+                utx = loot.back();
+                loot.pop_back();
+                auto lock = std::lock_guard(queues[self]->mutex);
+                queues[self]->nodes.insert(queues[self]->nodes.end(), loot.begin(), loot.end());
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto worker = [&, this](size_t self) {
+        auto lowered = std::vector<uint32_t>{};
+        auto utx = uint32_t{0};
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (!pop(self, utx)) {
+                if (pending.load() == 0) {
+                    return;  // quiescent
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            std::atomic_ref<uint8_t>(this->_active[utx]).exchange(0, std::memory_order_acq_rel);
+            const auto dist_u = std::atomic_ref<T>(dist[utx]).load(std::memory_order_relaxed);
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto vtx = targets[pos];
+                const auto improved
+                    = lower_locked(dist, pred, has_pred, std::span<uint8_t>(this->_locks), utx,
+                                   vtx, edges[pos], dist_u + weight[edges[pos]]);
+                if (improved
+                    && std::atomic_ref<uint8_t>(this->_active[vtx]).exchange(
+                           1, std::memory_order_acq_rel)
+                           == 0) {
+                    lowered.push_back(vtx);
+                }
+            }
+            if (!lowered.empty()) {
+                changed.store(true, std::memory_order_relaxed);
+                pending += lowered.size();
+                auto lock = std::lock_guard(queues[self]->mutex);
+                queues[self]->nodes.insert(queues[self]->nodes.end(), lowered.begin(),
+                                           lowered.end());
+                lowered.clear();
+            }
+            const auto degree = int64_t(offsets[utx + 1] - offsets[utx]);
+            if (budget.fetch_sub(degree + 1, std::memory_order_relaxed) <= degree + 1) {
+                stop.store(true, std::memory_order_relaxed);
+            }
+            --pending;
+        }
+    };
+
+    this->_team.run(threads, worker);
+
+    // the nodes left queued at the end of the budget seed the next epoch
+    this->_active_list.clear();
+    for (const auto &queue : queues) {
+        for (const auto vtx : queue->nodes) {
+            this->_active[vtx] = 0;
+            this->_active_list.push_back(vtx);
+        }
+    }
+    this->_steals += steals.load();
+    ++this->_async_epochs;
+    return changed.load() || !this->_active_list.empty();
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::_delta_step(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                             std::span<std::pair<uint32_t, uint32_t>> pred,
+                             std::span<uint8_t> has_pred) -> bool {
+    constexpr auto none = std::numeric_limits<uint32_t>::max();
+    constexpr auto max_buckets = size_t{1} << 16U;  // farther nodes share the last bucket
+    constexpr auto min_share = size_t{1024};        // frontier nodes per thread
+    const auto num_nodes = gra.num_nodes();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    if (this->_locks.size() != num_nodes) {
+        this->_locks.assign(num_nodes, 0);
+    }
+    if (this->_bucket_of.size() != num_nodes) {
+        this->_bucket_of.assign(num_nodes, none);
+    }
+    if (this->_all_active) {
+        this->_active_list.resize(num_nodes);
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            this->_active_list[vtx] = vtx;
+        }
+        this->_delta = this->_options.delta;
+        if (!(this->_delta > 0.0)) {
+            auto total = 0.0;
+            auto count = size_t{0};
+            for (const auto edge : edges) {
+                if (weight[edge] >= T(0)) {
+                    total += double(weight[edge]);
+                    ++count;
+                }
+            }
+            const auto degree = double(edges.size()) / double(std::max<uint32_t>(1, num_nodes));
+            this->_delta = count == 0 ? 1.0 : 2.0 * total / double(count) / std::max(1.0, degree);
+        }
+        if constexpr (std::integral<T>) {
+            this->_delta = std::max(1.0, std::ceil(this->_delta));
+        } else if (!(this->_delta > 0.0)) {
+            this->_delta = 1.0;
+        }
+    }
+    if (this->_active_list.empty()) {
+        return false;
+    }
+
+    const auto delta = this->_delta;
+    const auto light_limit = T(delta);
+    auto base = double(dist[this->_active_list.front()]);
+    for (const auto vtx : this->_active_list) {
+        base = std::min(base, double(dist[vtx]));
+    }
+    auto bucket_index = [&](T distance) -> size_t {
+        const auto offset = (double(distance) - base) / delta;
+        return offset > 0.0 ? size_t(std::min(offset, double(max_buckets - 1))) : 0;
+    };
+    auto insert = [&](uint32_t vtx, size_t idx) {
+        if (idx >= this->_buckets.size()) {
+            this->_buckets.resize(idx + 1);
+        }
+        this->_buckets[idx].push_back(vtx);
+        this->_bucket_of[vtx] = uint32_t(idx);
+    };
+    for (auto &bucket : this->_buckets) {
+        bucket.clear();
+    }
+    for (const auto vtx : this->_active_list) {
+        insert(vtx, bucket_index(dist[vtx]));
+    }
+    this->_active_list.clear();
+
+    // relaxes the light or the heavy out-edges of `nodes`, collecting the lowered targets
+    auto scan = [&](std::span<const uint32_t> nodes, bool light, std::vector<uint32_t> &lowered,
+                    bool locked) -> size_t {
+        auto scanned = size_t{0};
+        for (const auto utx : nodes) {
+            const auto dist_u
+                = locked ? std::atomic_ref<T>(dist[utx]).load(std::memory_order_relaxed)
+                         : dist[utx];
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto edge = edges[pos];
+                if ((weight[edge] < light_limit) != light) {
+                    continue;
+                }
+                const auto vtx = targets[pos];
+                const T distance = dist_u + weight[edge];
+                if (locked) {
+                    if (lower_locked(dist, pred, has_pred, std::span<uint8_t>(this->_locks), utx,
+                                     vtx, edge, distance)) {
+                        lowered.push_back(vtx);
+                    }
+                } else if (dist[vtx] > distance) {
+                    dist[vtx] = distance;
+                    pred[vtx] = {utx, edge};
+                    has_pred[vtx] = 1;
+                    lowered.push_back(vtx);
+                }
+            }
+            scanned += offsets[utx + 1] - offsets[utx];
+        }
+        return scanned;
+    };
+
+    auto budget = int64_t(std::max(1.0, this->_options.epoch_edges * double(edges.size())));
+    auto changed = false;
+    auto parts = std::vector<std::vector<uint32_t>>(std::max<size_t>(1, this->_options.threads));
+    auto cur = size_t{0};
+    auto run_phase = [&](std::span<const uint32_t> nodes, bool light) {
+        const auto threads = std::clamp<size_t>(nodes.size() / min_share, 1, parts.size());
+        auto scanned = std::vector<size_t>(threads, 0);
+        if (threads == 1) {
+            scanned[0] = scan(nodes, light, parts[0], false);
+        } else {
+            auto worker = [&](size_t i) {
+                const auto first = nodes.size() * i / threads;
+                const auto last = nodes.size() * (i + 1) / threads;
+                scanned[i] = scan(nodes.subspan(first, last - first), light, parts[i], true);
+            };
+            this->_team.run(threads, worker);
+        }
+        for (size_t i = 0; i != threads; ++i) {
+            budget -= int64_t(scanned[i]);
+            changed = changed || !parts[i].empty();
+            for (const auto vtx : parts[i]) {
+                insert(vtx, std::max(cur, bucket_index(dist[vtx])));
+            }
+            parts[i].clear();
+        }
+        ++this->_bucket_phases;
+    };
+
+    // `_next_active` marks the nodes of `settled`, whose heavy edges are still to relax
+    auto frontier = std::vector<uint32_t>{};
+    auto settled = std::vector<uint32_t>{};
+    for (; cur < this->_buckets.size() && budget > 0; ++cur) {
+        while (!this->_buckets[cur].empty() && budget > 0) {
+            while (!this->_buckets[cur].empty() && budget > 0) {
+                std::swap(frontier, this->_buckets[cur]);
+                this->_buckets[cur].clear();
+                frontier.erase(std::remove_if(frontier.begin(), frontier.end(),
+                                              [&](uint32_t vtx) {
+                                                  return this->_bucket_of[vtx] != cur;
+                                              }),
+                               frontier.end());
+                for (const auto vtx : frontier) {
+                    this->_bucket_of[vtx] = none;
+                    if (this->_next_active[vtx] == 0) {
+                        this->_next_active[vtx] = 1;
+                        settled.push_back(vtx);
+                    }
+                }
+                run_phase(frontier, true);
+            }
+            // even out of budget, so that the next epoch starts from the lowered nodes only
+            run_phase(settled, false);
+            for (const auto vtx : settled) {
+                this->_next_active[vtx] = 0;
+            }
+            settled.clear();
+        }
+    }
+
+    // out of budget: the queued nodes seed the next epoch
+    for (size_t idx = 0; idx != this->_buckets.size(); ++idx) {
+        for (const auto vtx : this->_buckets[idx]) {
+            if (this->_bucket_of[vtx] == idx) {
+                this->_bucket_of[vtx] = none;
+                if (this->_active[vtx] == 0) {
+                    this->_active[vtx] = 1;
+                    this->_active_list.push_back(vtx);
+                }
+            }
+        }
+        this->_buckets[idx].clear();
+    }
+    for (const auto vtx : this->_active_list) {
+        this->_active[vtx] = 0;
+    }
+    return changed || !this->_active_list.empty();
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::_label_correcting(const CsrGraph &gra, std::span<const T> weight,
+                                   std::span<T> dist,
+                                   std::span<std::pair<uint32_t, uint32_t>> pred,
+                                   std::span<uint8_t> has_pred) -> bool {
+    const auto num_nodes = gra.num_nodes();
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    const auto threshold = this->_options.mode == RelaxMode::Threshold;
+    if (this->_all_active) {
+        this->_active_list.resize(num_nodes);
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            this->_active_list[vtx] = vtx;
+        }
+        this->_scanned.assign(num_nodes, 0);
+    }
+    if (this->_active_list.empty()) {
+        return false;
+    }
+
+    // `_active` marks the queued nodes; `Threshold` scans `now` and lets the others wait in
+    // `next`, `Deque` uses `now` only
+    auto now = std::deque<uint32_t>{};
+    auto next = std::vector<uint32_t>{};
+    for (const auto vtx : this->_active_list) {
+        this->_active[vtx] = 1;
+    }
+    if (threshold) {
+        next.swap(this->_active_list);
+    } else {
+        now.assign(this->_active_list.begin(), this->_active_list.end());
+    }
+    this->_active_list.clear();
+
+    auto budget = int64_t(std::max(1.0, this->_options.epoch_edges * double(edges.size())));
+    auto changed = false;
+    while (budget > 0) {
+        if (now.empty()) {
+            if (next.empty()) {
+                break;
+            }
+            auto lowest = double(dist[next.front()]);
+            auto total = 0.0;
+            for (const auto vtx : next) {
+                lowest = std::min(lowest, double(dist[vtx]));
+                total += double(dist[vtx]);
+            }
+            const auto mean = total / double(next.size());
+            const auto limit = lowest + (mean - lowest) * this->_options.threshold;
+            const auto least = (next.size() + 15) / 16;
+            auto kept = size_t{0};
+            for (const auto vtx : next) {
+                if (double(dist[vtx]) <= limit) {
+                    now.push_back(vtx);
+                } else {
+                    next[kept++] = vtx;
+                }
+            }
+            next.resize(kept);
+            if (now.size() < least) {
+                // a few outliers far below the mean would make every round rescan `next`
+                const auto more = std::ptrdiff_t(least - now.size());
+                std::nth_element(next.begin(), next.begin() + more - 1, next.end(),
+                                 [&](uint32_t lhs, uint32_t rhs) { return dist[lhs] < dist[rhs]; });
+                now.insert(now.end(), next.begin(), next.begin() + more);
+                next.erase(next.begin(), next.begin() + more);
+            }
+        }
+
+        const auto utx = now.front();
+        now.pop_front();
+        this->_active[utx] = 0;
+        this->_scanned[utx] = 1;
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            const auto vtx = targets[pos];
+            const auto distance = dist[utx] + weight[edges[pos]];
+            if (!(dist[vtx] > distance)) {
+                continue;
+            }
+            dist[vtx] = distance;
+            pred[vtx] = {utx, edges[pos]};
+            has_pred[vtx] = 1;
+            changed = true;
+            if (this->_active[vtx] != 0) {
+                continue;
+            }
+            this->_active[vtx] = 1;
+            if (threshold) {
+                next.push_back(vtx);
+            } else if (this->_scanned[vtx] != 0) {
+                now.push_front(vtx);
+            } else {
+                now.push_back(vtx);
+            }
+        }
+        budget -= int64_t(offsets[utx + 1] - offsets[utx]) + 1;
+        ++this->_scans;
+    }
+
+    // out of budget: the queued nodes seed the next epoch, in their order
+    this->_active_list.assign(now.begin(), now.end());
+    this->_active_list.insert(this->_active_list.end(), next.begin(), next.end());
+    for (const auto vtx : this->_active_list) {
+        this->_active[vtx] = 0;
+    }
+    return changed || !this->_active_list.empty();
+}
+
+template <KernelDomain T>
+auto CsrRelaxer::relax(const CsrGraph &gra, std::span<const T> weight, std::span<T> dist,
+                       std::span<std::pair<uint32_t, uint32_t>> pred,
+                       std::span<uint8_t> has_pred) -> bool {
+    if (this->_options.mode == RelaxMode::Sweep) {
+        ++this->_push_passes;
+        return relax_csr(gra.offsets(), gra.targets(), gra.edge_ids(), weight, dist, pred,
+                         has_pred);
+    }
+
+    const auto num_nodes = gra.num_nodes();
+    if (this->_all_active) {
+        this->_active.assign(num_nodes, 0);
+        this->_next_active.assign(num_nodes, 0);
+        this->_active_list.clear();
+    }
+    this->_next_list.clear();
+    if (this->_options.mode == RelaxMode::Blocked) {
+        const auto changed = this->_blocked(gra, weight, dist, pred, has_pred);
+        this->_all_active = false;
+        return changed;
+    }
+    if (this->_options.mode == RelaxMode::Async) {
+        const auto changed = this->_async(gra, weight, dist, pred, has_pred);
+        this->_all_active = false;
+        return changed;
+    }
+    if (this->_options.mode == RelaxMode::Delta) {
+        const auto changed = this->_delta_step(gra, weight, dist, pred, has_pred);
+        this->_all_active = false;
+        return changed;
+    }
+    if (this->_options.mode == RelaxMode::Deque || this->_options.mode == RelaxMode::Threshold) {
+        const auto changed = this->_label_correcting(gra, weight, dist, pred, has_pred);
+        this->_all_active = false;
+        return changed;
+    }
+
+    const auto num_active = this->_all_active ? num_nodes : this->_active_list.size();
+    const auto sweep = this->_options.mode == RelaxMode::Adaptive
+                       && double(num_active) >= this->_options.sweep_fraction * double(num_nodes);
+    const auto pull = !sweep && this->_options.threads > 1
+                      && double(num_active) >= this->_options.pull_fraction * double(num_nodes);
+    const auto changed = sweep  ? this->_sweep(gra, weight, dist, pred, has_pred)
+                         : pull ? this->_pull(gra, weight, dist, pred, has_pred)
+                                : this->_push(gra, weight, dist, pred, has_pred);
+
+    // the nodes lowered in this pass are the active nodes of the next one
+    for (const auto vtx : this->_active_list) {
+        this->_active[vtx] = 0;
+    }
+    for (const auto vtx : this->_next_list) {
+        this->_next_active[vtx] = 0;
+        this->_active[vtx] = 1;
+    }
+    std::swap(this->_active_list, this->_next_list);
+    this->_all_active = false;
+    return changed;
+}
+
+#define DIGRAPHX_RELAXER_INSTANCE(T)                                                              \
+    template auto CsrRelaxer::relax<T>(const CsrGraph &, std::span<const T>, std::span<T>,       \
+                                       std::span<std::pair<uint32_t, uint32_t>>,                  \
+                                       std::span<uint8_t>) -> bool;
+DIGRAPHX_CSR_DOMAINS(DIGRAPHX_RELAXER_INSTANCE)
+#undef DIGRAPHX_RELAXER_INSTANCE
@@ -0,0 +1,167 @@
+#include <algorithm>  // for all_of, any_of, fill, max, max_element, min
+#include <cmath>      // for floor
+#include <digraphx/min_cycle_ratio.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <digraphx/retiming.hpp>
+#include <limits>
+#include <stdexcept>  // for invalid_argument
+
+using namespace digraphx;
+
+Retiming::Retiming(std::span<const double> delay, std::span<const uint32_t> from,
+                   std::span<const uint32_t> to, std::span<const uint32_t> registers)
+    : _delay(delay.begin(), delay.end()), _weight(registers.begin(), registers.end()) {
+    if (registers.size() != from.size()) {
+        throw std::invalid_argument("Retiming: array sizes differ");
+    }
+    if (std::any_of(delay.begin(), delay.end(), [](double d) { return !(d >= 0.0); })) {
+        throw std::invalid_argument("Retiming: negative gate delay");
+    }
+    this->_csr.assign(delay.size(), from, to);
+
+    // A cycle of wires without registers is a negative cycle when those wires weigh -1 and
+    // all others are too heavy to ever be relaxed.
+    auto weight = std::vector<double>(registers.size());
+    for (size_t i = 0; i != registers.size(); ++i) {
+        weight[i] = registers[i] == 0 ? -1.0 : std::numeric_limits<double>::infinity();
+    }
+    auto dist = std::vector<double>(delay.size(), 0.0);
+    auto ncf = NegCycleFinder<CsrGraph>(this->_csr);
+    for (const auto &cycle : ncf.howard(dist, EdgeWeights<double>(weight))) {
+        if (!cycle.empty()) {
+            throw std::invalid_argument("Retiming: combinational cycle without registers");
+        }
+    }
+}
+
+/**
+ * The function computes the arrival time of every gate in the combinational part of the circuit
+ * retimed by `lag`, i.e. over the wires left without registers, and returns the largest one. It
+ * returns infinity if those wires form a cycle or some wire holds a negative number of registers;
+ * in the latter case every arrival time is infinity too, so none is left from an earlier call.
+ */
+auto Retiming::_arrival(std::span<const int64_t> lag) -> double {
+    const auto num_nodes = this->_csr.num_nodes();
+    const auto offsets = this->_csr.offsets();
+    const auto targets = this->_csr.targets();
+    const auto edges = this->_csr.edge_ids();
+    auto retimed = [&](uint32_t utx, size_t pos) -> int64_t {
+        return int64_t(this->_weight[edges[pos]]) + lag[targets[pos]] - lag[utx];
+    };
+
+    const auto inf = std::numeric_limits<double>::infinity();
+    this->_arrival_time.assign(this->_delay.begin(), this->_delay.end());
+    this->_indegree.assign(num_nodes, 0);
+    for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            const auto regs = retimed(utx, pos);
+            if (regs < 0) {
+                // not a legal retiming, so no arrival time is met
+                std::fill(this->_arrival_time.begin(), this->_arrival_time.end(), inf);
+                return inf;
+            }
+            this->_indegree[targets[pos]] += regs == 0 ? 1 : 0;
+        }
+    }
+    this->_queue.clear();
+    for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+        if (this->_indegree[vtx] == 0) {
+            this->_queue.push_back(vtx);
+        }
+    }
+    for (size_t head = 0; head != this->_queue.size(); ++head) {
+        const auto utx = this->_queue[head];
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            if (retimed(utx, pos) != 0) {
+                continue;
+            }
+            const auto vtx = targets[pos];
+            this->_arrival_time[vtx] = std::max(this->_arrival_time[vtx],
+                                                this->_arrival_time[utx] + this->_delay[vtx]);
+            if (--this->_indegree[vtx] == 0) {
+                this->_queue.push_back(vtx);
+            }
+        }
+    }
+    if (this->_queue.size() != num_nodes) {
+        return inf;
+    }
+    return num_nodes == 0 ? 0.0
+                          : *std::max_element(this->_arrival_time.begin(),
+                                              this->_arrival_time.end());
+}
+
+auto Retiming::feasible(double period, std::vector<int64_t> &lag) -> double {
+    const auto num_nodes = this->_csr.num_nodes();
+    lag.assign(num_nodes, 0);
+    for (size_t iter = 0; iter + 1 < num_nodes; ++iter) {
+        if (this->_arrival(lag) <= period) {
+            break;
+        }
+        for (size_t vtx = 0; vtx != num_nodes; ++vtx) {
+            lag[vtx] += this->_arrival_time[vtx] > period ? 1 : 0;
+        }
+    }
+    const auto achieved = this->_arrival(lag);
+    return achieved <= period ? achieved : -1.0;
+}
+
+auto Retiming::min_period() -> RetimingResult {
+    auto result = RetimingResult{};
+    const auto num_nodes = this->_csr.num_nodes();
+
+    // Maximum cycle ratio: the minimum of sum(-d) / sum(w) over the cycles, negated.
+    auto cost = std::vector<double>(this->_weight.size());
+    auto time = std::vector<double>(this->_weight.size());
+    for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+        for (const auto &[vtx, edge] : this->_csr.neighbors(utx)) {
+            cost[edge] = -this->_delay[utx];
+            time[edge] = double(this->_weight[edge]);
+        }
+    }
+    auto ratio = 0.0;
+    auto dist = std::vector<double>(num_nodes, 0.0);
+    min_cycle_ratio(this->_csr, ratio, EdgeWeights<double>(cost), EdgeWeights<double>(time), dist,
+                    0.0);
+    result.cycle_bound = -ratio;
+
+    const auto d_max
+        = num_nodes == 0 ? 0.0 : *std::max_element(this->_delay.begin(), this->_delay.end());
+    const auto integral = std::all_of(this->_delay.begin(), this->_delay.end(),
+                                      [](double d) { return d == std::floor(d); });
+    auto lo = std::max(result.cycle_bound, d_max);
+    auto lag = std::vector<int64_t>{};
+
+    // The circuit as given is always feasible; the bound below usually is too.
+    result.retiming.assign(num_nodes, 0);
+    auto hi = this->_arrival(result.retiming);
+    const auto bound = this->feasible(std::min(hi, result.cycle_bound + d_max), lag);
+    if (bound >= 0.0 && bound < hi) {
+        hi = bound;
+        result.retiming = lag;
+    }
+    if (const auto at_lo = this->feasible(lo, lag); at_lo >= 0.0) {
+        hi = at_lo;
+        result.retiming = lag;
+    }
+    while (hi > lo && hi - lo > 1e-9 * std::max(1.0, hi) && !(integral && hi - lo < 1.0)) {
+        const auto mid = lo + (hi - lo) / 2.0;
+        const auto achieved = this->feasible(mid, lag);
+        if (achieved >= 0.0) {
+            hi = achieved;
+            result.retiming = lag;
+        } else {
+            lo = mid;
+        }
+    }
+
+    result.period = hi;
+    result.registers.resize(this->_weight.size());
+    for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+        for (const auto &[vtx, edge] : this->_csr.neighbors(utx)) {
+            result.registers[edge]
+                = int64_t(this->_weight[edge]) + result.retiming[vtx] - result.retiming[utx];
+        }
+    }
+    return result;
+}
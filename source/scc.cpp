@@ -0,0 +1,692 @@
+#include <algorithm>  // for max, sort
+#include <atomic>     // for atomic, atomic_ref
+#include <digraphx/scc.hpp>
+#include <digraphx/thread_team.hpp>  // for ThreadTeam
+#include <span>
+#include <stdexcept>  // for invalid_argument
+#include <utility>  // for pair
+
+using namespace digraphx;
+
+namespace {
+
+    constexpr auto none = ~uint32_t(0);
+
+    /** Degree count of a node that was gone before the trimming; decrements never reach 0 */
+    constexpr auto gone = uint32_t(1) << 31U;
+
+    /** Frontiers of fewer nodes per thread are expanded on the calling thread */
+    constexpr size_t min_share = 1024;
+
+    /** First of the `parts` about equal slices of `size` items taken by part `idx` */
+    auto slice_begin(size_t size, size_t idx, size_t parts) -> size_t {
+        return size * idx / parts;
+    }
+
+    template <typename T> auto load(T &value) -> T {
+        return std::atomic_ref<T>(value).load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The state of one decomposition
+     *
+     * `_label` holds the representative node of each node's component once it
+     * is found, and `none` while the node is live. A node leaves the live set
+     * exactly once, by the thread that sets its label.
+     */
+    class Decomposer {
+        const CsrGraph &_gra;
+        std::span<const uint32_t> _in_offsets;
+        std::span<const uint32_t> _in_sources;
+        size_t _threads;
+        size_t _live;
+        std::vector<uint32_t> _label;
+        std::vector<uint32_t> _in_count{};   // live in-neighbors other than the node itself
+        std::vector<uint32_t> _out_count{};  // live out-neighbors other than the node itself
+        std::vector<uint8_t> _mark{};        // 1 once reached forward, 2 also backward
+        std::vector<uint32_t> _color{};
+        ThreadTeam _team{};  // runs the parallel steps of all rounds
+
+      public:
+        size_t trimmed{0};
+        size_t color_rounds{0};
+
+        Decomposer(const CsrGraph &gra, const CsrTranspose &transpose, size_t threads)
+            : _gra{gra},
+              _in_offsets{transpose.offsets},
+              _in_sources{transpose.sources},
+              _threads{std::max<size_t>(1, threads)},
+              _live{gra.num_nodes()},
+              _label(gra.num_nodes(), none) {}
+
+        auto live() const -> size_t { return this->_live; }
+        auto label() const -> const std::vector<uint32_t> & { return this->_label; }
+
+        /** Counts the live in- and out-neighbors of the live nodes, in parallel */
+        void count_live() {
+            const auto num_nodes = this->_gra.num_nodes();
+            const auto offsets = this->_gra.offsets();
+            const auto targets = this->_gra.targets();
+            this->_in_count.resize(num_nodes);
+            this->_out_count.resize(num_nodes);
+            this->_team.run(this->_threads, [&, this](size_t idx) {
+                const auto first = uint32_t(slice_begin(num_nodes, idx, this->_threads));
+                const auto last = uint32_t(slice_begin(num_nodes, idx + 1, this->_threads));
+                for (auto vtx = first; vtx != last; ++vtx) {
+                    if (this->_label[vtx] != none) {
+                        this->_in_count[vtx] = this->_out_count[vtx] = gone;
+                        continue;
+                    }
+                    auto out_count = uint32_t{0};
+                    for (auto pos = offsets[vtx]; pos != offsets[vtx + 1]; ++pos) {
+                        const auto wtx = targets[pos];
+                        out_count += wtx != vtx && this->_label[wtx] == none ? 1 : 0;
+                    }
+                    auto in_count = uint32_t{0};
+                    for (auto pos = this->_in_offsets[vtx]; pos != this->_in_offsets[vtx + 1];
+                         ++pos) {
+                        const auto wtx = this->_in_sources[pos];
+                        in_count += wtx != vtx && this->_label[wtx] == none ? 1 : 0;
+                    }
+                    this->_out_count[vtx] = out_count;
+                    this->_in_count[vtx] = in_count;
+                }
+            });
+        }
+
+        /**
+         * @brief Removes the trivial components, each thread peeling from its node range
+         *
+         * @return the number of nodes removed
+         */
+        auto trim() -> size_t {
+            this->count_live();
+            const auto num_nodes = this->_gra.num_nodes();
+            const auto offsets = this->_gra.offsets();
+            const auto targets = this->_gra.targets();
+            auto removed = std::atomic<size_t>{0};
+            this->_team.run(this->_threads, [&, this](size_t idx) {
+                auto stack = std::vector<uint32_t>{};
+                auto claim = [&, this](uint32_t vtx) {
+                    auto expected = none;
+                    if (std::atomic_ref<uint32_t>(this->_label[vtx])
+                            .compare_exchange_strong(expected, vtx, std::memory_order_relaxed)) {
+                        stack.push_back(vtx);
+                    }
+                };
+                auto count_down = [&](std::vector<uint32_t> &count, uint32_t vtx) {
+                    if (std::atomic_ref<uint32_t>(count[vtx]).fetch_sub(
+                            1, std::memory_order_relaxed)
+                        == 1) {
+                        claim(vtx);
+                    }
+                };
+                auto local = size_t{0};
+                const auto first = uint32_t(slice_begin(num_nodes, idx, this->_threads));
+                const auto last = uint32_t(slice_begin(num_nodes, idx + 1, this->_threads));
+                for (auto vtx = first; vtx != last; ++vtx) {
+                    if (load(this->_in_count[vtx]) == 0 || load(this->_out_count[vtx]) == 0) {
+                        claim(vtx);
+                    }
+                    while (!stack.empty()) {
+                        const auto utx = stack.back();
+                        stack.pop_back();
+                        ++local;
+                        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                            if (targets[pos] != utx) {
+                                count_down(this->_in_count, targets[pos]);
+                            }
+                        }
+                        for (auto pos = this->_in_offsets[utx]; pos != this->_in_offsets[utx + 1];
+                             ++pos) {
+                            if (this->_in_sources[pos] != utx) {
+                                count_down(this->_out_count, this->_in_sources[pos]);
+                            }
+                        }
+                    }
+                }
+                removed += local;
+            });
+            this->_live -= removed;
+            this->trimmed += removed;
+            return removed;
+        }
+
+        /**
+         * @brief Marks the live nodes reachable from `root` with `to`, following out-edges
+         * (or in-edges if not `forward`) through nodes marked `from`, level by level
+         */
+        void search(uint32_t root, uint8_t from, uint8_t to, bool forward) {
+            const auto offsets
+                = forward ? this->_gra.offsets() : std::span<const uint32_t>(this->_in_offsets);
+            const auto adjacent
+                = forward ? this->_gra.targets() : std::span<const uint32_t>(this->_in_sources);
+            this->_mark[root] = to;
+            auto frontier = std::vector<uint32_t>{root};
+            auto nexts = std::vector<std::vector<uint32_t>>(this->_threads);
+            auto expand = [&, this](size_t idx, size_t parts) {
+                auto &next = nexts[idx];
+                next.clear();
+                const auto last = slice_begin(frontier.size(), idx + 1, parts);
+                for (auto i = slice_begin(frontier.size(), idx, parts); i != last; ++i) {
+                    const auto utx = frontier[i];
+                    for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                        const auto wtx = adjacent[pos];
+                        auto expected = from;
+                        if (load(this->_mark[wtx]) == from && this->_label[wtx] == none
+                            && std::atomic_ref<uint8_t>(this->_mark[wtx])
+                                   .compare_exchange_strong(expected, to,
+                                                            std::memory_order_relaxed)) {
+                            next.push_back(wtx);
+                        }
+                    }
+                }
+                // the next level is expanded in node order, which reads the CSR arrays
+                // front to back instead of at random
+                std::sort(next.begin(), next.end());
+            };
+            while (!frontier.empty()) {
+                if (frontier.size() < min_share * this->_threads) {
+                    expand(0, 1);
+                    frontier.swap(nexts[0]);
+                    continue;
+                }
+                this->_team.run(this->_threads, [&](size_t idx) { expand(idx, this->_threads); });
+                frontier.clear();
+                for (const auto &next : nexts) {
+                    frontier.insert(frontier.end(), next.begin(), next.end());
+                }
+            }
+        }
+
+        /**
+         * @brief Removes the component of the live node with the largest degree product
+         *
+         * @return the number of nodes removed
+         */
+        auto forward_backward() -> size_t {
+            const auto num_nodes = this->_gra.num_nodes();
+            this->count_live();
+            auto best = std::vector<std::pair<uint64_t, uint32_t>>(this->_threads, {0, none});
+            this->_team.run(this->_threads, [&, this](size_t idx) {
+                const auto first = uint32_t(slice_begin(num_nodes, idx, this->_threads));
+                const auto last = uint32_t(slice_begin(num_nodes, idx + 1, this->_threads));
+                for (auto vtx = first; vtx != last; ++vtx) {
+                    const auto product
+                        = uint64_t(this->_in_count[vtx]) * uint64_t(this->_out_count[vtx]);
+                    if (this->_label[vtx] == none && (best[idx].second == none
+                                                      || product > best[idx].first)) {
+                        best[idx] = {product, vtx};
+                    }
+                }
+            });
+            auto pivot = none;
+            auto product = uint64_t{0};
+            for (const auto &[value, vtx] : best) {
+                if (vtx != none && (pivot == none || value > product)) {
+                    pivot = vtx;
+                    product = value;
+                }
+            }
+            if (pivot == none) {
+                return 0;
+            }
+
+            this->_mark.assign(num_nodes, 0);
+            this->search(pivot, 0, 1, true);
+            this->search(pivot, 1, 2, false);
+            auto removed = std::atomic<size_t>{0};
+            this->_team.run(this->_threads, [&, this](size_t idx) {
+                auto local = size_t{0};
+                const auto first = uint32_t(slice_begin(num_nodes, idx, this->_threads));
+                const auto last = uint32_t(slice_begin(num_nodes, idx + 1, this->_threads));
+                for (auto vtx = first; vtx != last; ++vtx) {
+                    if (this->_mark[vtx] == 2) {
+                        this->_label[vtx] = pivot;
+                        ++local;
+                    }
+                }
+                removed += local;
+            });
+            this->_live -= removed;
+            return removed;
+        }
+
+        /**
+         * @brief Removes the components of the roots of one coloring
+         *
+         * @return the number of nodes removed
+         */
+        auto color() -> size_t {
+            const auto num_nodes = this->_gra.num_nodes();
+            this->_color.resize(num_nodes);
+            for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+                this->_color[vtx] = this->_label[vtx] == none ? vtx : none;
+            }
+            auto changed = std::atomic<bool>{true};
+            while (changed) {
+                changed = false;
+                ++this->color_rounds;
+                // Every node is written by the thread owning it, and reads of the colors other
+                // threads are raising only speed the propagation up.
+                this->_team.run(this->_threads, [&, this](size_t idx) {
+                    auto local = false;
+                    const auto first = uint32_t(slice_begin(num_nodes, idx, this->_threads));
+                    const auto last = uint32_t(slice_begin(num_nodes, idx + 1, this->_threads));
+                    for (auto vtx = first; vtx != last; ++vtx) {
+                        if (this->_label[vtx] != none) {
+                            continue;
+                        }
+                        auto best = load(this->_color[vtx]);
+                        for (auto pos = this->_in_offsets[vtx]; pos != this->_in_offsets[vtx + 1];
+                             ++pos) {
+                            const auto wtx = this->_in_sources[pos];
+                            if (this->_label[wtx] == none) {
+                                best = std::max(best, load(this->_color[wtx]));
+                            }
+                        }
+                        if (best != load(this->_color[vtx])) {
+                            std::atomic_ref<uint32_t>(this->_color[vtx])
+                                .store(best, std::memory_order_relaxed);
+                            local = true;
+                        }
+                    }
+                    if (local) {
+                        changed = true;
+                    }
+                });
+            }
+
+            auto roots = std::vector<uint32_t>{};
+            for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+                if (this->_color[vtx] == vtx) {
+                    roots.push_back(vtx);
+                }
+            }
+            // The nodes of a color are searched by one thread only, and colors never change
+            // during the searches, so checking the color first keeps the threads apart.
+            auto next = std::atomic<size_t>{0};
+            auto removed = std::atomic<size_t>{0};
+            this->_team.run(std::min(this->_threads, roots.size()), [&, this](size_t) {
+                auto stack = std::vector<uint32_t>{};
+                auto local = size_t{0};
+                for (auto idx = next++; idx < roots.size(); idx = next++) {
+                    const auto root = roots[idx];
+                    this->_label[root] = root;
+                    stack.push_back(root);
+                    while (!stack.empty()) {
+                        const auto utx = stack.back();
+                        stack.pop_back();
+                        ++local;
+                        for (auto pos = this->_in_offsets[utx]; pos != this->_in_offsets[utx + 1];
+                             ++pos) {
+                            const auto wtx = this->_in_sources[pos];
+                            if (this->_color[wtx] == root && this->_label[wtx] == none) {
+                                this->_label[wtx] = root;
+                                stack.push_back(wtx);
+                            }
+                        }
+                    }
+                }
+                removed += local;
+            });
+            this->_live -= removed;
+            return removed;
+        }
+
+        /** Tarjan's algorithm without recursion, on the live nodes */
+        void tarjan() {
+            const auto num_nodes = uint32_t(this->_gra.num_nodes());
+            const auto offsets = this->_gra.offsets();
+            const auto targets = this->_gra.targets();
+            auto index = std::vector<uint32_t>(num_nodes, none);
+            auto low = std::vector<uint32_t>(num_nodes, 0);
+            auto on_stack = std::vector<bool>(num_nodes, false);
+            auto stack = std::vector<uint32_t>{};
+            auto frames = std::vector<std::pair<uint32_t, uint32_t>>{};  // node, next position
+            auto counter = uint32_t{0};
+            for (uint32_t root = 0; root != num_nodes; ++root) {
+                if (this->_label[root] != none || index[root] != none) {
+                    continue;
+                }
+                frames.emplace_back(root, offsets[root]);
+                index[root] = low[root] = counter++;
+                stack.push_back(root);
+                on_stack[root] = true;
+                while (!frames.empty()) {
+                    auto &[utx, pos] = frames.back();
+                    if (pos != offsets[utx + 1]) {
+                        const auto vtx = targets[pos++];
+                        if (this->_label[vtx] != none) {
+                            continue;  // in a component found before
+                        }
+                        if (index[vtx] == none) {
+                            index[vtx] = low[vtx] = counter++;
+                            stack.push_back(vtx);
+                            on_stack[vtx] = true;
+                            frames.emplace_back(vtx, offsets[vtx]);
+                        } else if (on_stack[vtx]) {
+                            low[utx] = std::min(low[utx], index[vtx]);
+                        }
+                        continue;
+                    }
+                    const auto node = utx;
+                    frames.pop_back();
+                    if (!frames.empty()) {
+                        const auto parent = frames.back().first;
+                        low[parent] = std::min(low[parent], low[node]);
+                    }
+                    if (low[node] != index[node]) {
+                        continue;
+                    }
+                    auto member = uint32_t{0};
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        on_stack[member] = false;
+                        this->_label[member] = node;
+                        --this->_live;
+                    } while (member != node);
+                }
+            }
+        }
+    };
+
+    void check_transpose(const CsrGraph &gra, const CsrTranspose &transpose) {
+        if (!transpose.fits(gra)) {
+            throw std::invalid_argument("CsrTranspose does not fit the graph");
+        }
+    }
+
+}  // namespace
+
+auto digraphx::trim_trivial(const CsrGraph &gra, const CsrTranspose &transpose, size_t threads)
+    -> std::vector<uint8_t> {
+    check_transpose(gra, transpose);
+    auto dec = Decomposer(gra, transpose, threads);
+    dec.trim();
+    auto trimmed = std::vector<uint8_t>(gra.num_nodes());
+    for (size_t vtx = 0; vtx != trimmed.size(); ++vtx) {
+        trimmed[vtx] = dec.label()[vtx] != none ? 1 : 0;
+    }
+    return trimmed;
+}
+
+auto digraphx::strongly_connected_components(const CsrGraph &gra, const SccOptions &options)
+    -> Components {
+    const auto serial = options.threads <= 1 || gra.num_nodes() < options.serial_below;
+    return strongly_connected_components(gra, serial ? CsrTranspose{} : CsrTranspose(gra),
+                                         options);
+}
+
+auto digraphx::strongly_connected_components(const CsrGraph &gra, const CsrTranspose &transpose,
+                                             const SccOptions &options) -> Components {
+    const auto serial = options.threads <= 1 || gra.num_nodes() < options.serial_below;
+    if (!serial) {
+        check_transpose(gra, transpose);
+    }
+    auto dec = Decomposer(gra, transpose, options.threads);
+    if (!serial) {
+        dec.trim();
+        dec.forward_backward();
+        dec.trim();
+        while (dec.live() != 0 && dec.live() >= options.serial_below) {
+            dec.color();
+            dec.trim();
+        }
+    }
+    dec.tarjan();
+
+    auto scc = Components{};
+    scc.trimmed = dec.trimmed;
+    scc.color_rounds = dec.color_rounds;
+    scc.component.resize(gra.num_nodes());
+    auto number = std::vector<uint32_t>(gra.num_nodes(), none);
+    for (size_t vtx = 0; vtx != gra.num_nodes(); ++vtx) {
+        auto &comp = number[dec.label()[vtx]];
+        if (comp == none) {
+            comp = scc.count++;
+        }
+        scc.component[vtx] = comp;
+    }
+    return scc;
+}
+
+auto digraphx::condense(const CsrGraph &gra, const Components &scc) -> Condensation {
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    // the nodes grouped by component, with a counting sort
+    auto first = std::vector<uint32_t>(scc.count + 1, 0);
+    for (const auto comp : scc.component) {
+        ++first[comp + 1];
+    }
+    for (size_t comp = 0; comp != scc.count; ++comp) {
+        first[comp + 1] += first[comp];
+    }
+    auto members = std::vector<uint32_t>(scc.component.size());
+    auto fill = std::vector<uint32_t>(first.begin(), first.end() - 1);
+    for (uint32_t vtx = 0; vtx != scc.component.size(); ++vtx) {
+        members[fill[scc.component[vtx]]++] = vtx;
+    }
+
+    auto source = std::vector<uint32_t>{};
+    auto target = std::vector<uint32_t>{};
+    auto result = Condensation{};
+    auto seen = std::vector<uint32_t>(scc.count, none);  // last component with an edge to it
+    for (uint32_t comp = 0; comp != scc.count; ++comp) {
+        for (auto idx = first[comp]; idx != first[comp + 1]; ++idx) {
+            const auto utx = members[idx];
+            for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+                const auto other = scc.component[targets[pos]];
+                if (other != comp && seen[other] != comp) {
+                    seen[other] = comp;
+                    source.push_back(comp);
+                    target.push_back(other);
+                    result.edge.push_back(edges[pos]);
+                }
+            }
+        }
+    }
+    result.dag.assign(scc.count, source, target);
+    return result;
+}
+
+auto digraphx::cyclic_edges(const CsrGraph &gra, const Components &scc) -> std::vector<uint32_t> {
+    const auto offsets = gra.offsets();
+    const auto targets = gra.targets();
+    const auto edges = gra.edge_ids();
+    auto result = std::vector<uint32_t>{};
+    for (uint32_t utx = 0; utx != gra.num_nodes(); ++utx) {
+        for (auto pos = offsets[utx]; pos != offsets[utx + 1]; ++pos) {
+            if (scc.component[targets[pos]] == scc.component[utx]) {
+                result.push_back(edges[pos]);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+IncrementalScc::IncrementalScc(size_t num_nodes) {
+    for (size_t vtx = 0; vtx != num_nodes; ++vtx) {
+        this->add_node();
+    }
+}
+
+auto IncrementalScc::add_node() -> uint32_t {
+    const auto vtx = uint32_t(this->_parent.size());
+    this->_parent.push_back(vtx);
+    this->_size.push_back(1);
+    this->_order.push_back(this->_next_order++);
+    this->_out.emplace_back();
+    this->_in.emplace_back();
+    this->_forward_seen.push_back(0);
+    this->_backward_seen.push_back(0);
+    ++this->_count;
+    return vtx;
+}
+
+auto IncrementalScc::find(uint32_t vtx) const -> uint32_t {
+    while (this->_parent[vtx] != vtx) {
+        vtx = this->_parent[vtx];
+    }
+    return vtx;
+}
+
+/** The root of `vtx`, halving the path to it */
+auto IncrementalScc::_root(uint32_t vtx) -> uint32_t {
+    while (this->_parent[vtx] != vtx) {
+        this->_parent[vtx] = this->_parent[this->_parent[vtx]];
+        vtx = this->_parent[vtx];
+    }
+    return vtx;
+}
+
+/**
+ * The function collects the roots reachable from `root` (forward) or reaching
+ * it (backward) through components whose position is at most `bound`
+ * (forward) or at least `bound` (backward), into `_forward` or `_backward`.
+ */
+void IncrementalScc::_search(uint32_t root, bool forward, uint32_t bound) {
+    auto &seen = forward ? this->_forward_seen : this->_backward_seen;
+    auto &found = forward ? this->_forward : this->_backward;
+    found.clear();
+    seen[root] = this->_stamp;
+    this->_stack.assign(1, root);
+    while (!this->_stack.empty()) {
+        const auto comp = this->_stack.back();
+        this->_stack.pop_back();
+        found.push_back(comp);
+        const auto &adjacent = forward ? this->_out[comp] : this->_in[comp];
+        for (const auto vtx : adjacent) {
+            const auto other = this->_root(vtx);
+            if (other == comp || seen[other] == this->_stamp) {
+                continue;
+            }
+            if (forward ? this->_order[other] <= bound : this->_order[other] >= bound) {
+                seen[other] = this->_stamp;
+                this->_stack.push_back(other);
+            }
+        }
+    }
+}
+
+/** Unites the components of `roots` into the largest of them, at position `order` */
+void IncrementalScc::_merge(std::span<const uint32_t> roots, uint32_t order) {
+    auto root = roots.front();
+    for (const auto comp : roots) {
+        root = this->_size[comp] > this->_size[root] ? comp : root;
+    }
+    const auto append = [](std::vector<uint32_t> &into, std::vector<uint32_t> &from) {
+        if (from.size() > into.size()) {
+            into.swap(from);
+        }
+        into.insert(into.end(), from.begin(), from.end());
+        std::vector<uint32_t>{}.swap(from);
+    };
+    for (const auto comp : roots) {
+        if (comp != root) {
+            this->_parent[comp] = root;
+            this->_size[root] += this->_size[comp];
+            append(this->_out[root], this->_out[comp]);
+            append(this->_in[root], this->_in[comp]);
+        }
+    }
+    this->_order[root] = order;
+    this->_count -= roots.size() - 1;
+    this->_merges += roots.size() - 1;
+}
+
+auto IncrementalScc::add_edge(uint32_t utx, uint32_t vtx) -> bool {
+    if (utx >= this->num_nodes() || vtx >= this->num_nodes()) {
+        throw std::invalid_argument("IncrementalScc::add_edge: node out of range");
+    }
+    const auto source = this->_root(utx);
+    const auto target = this->_root(vtx);
+    if (source == target) {
+        return false;  // within a component, so on no path between components
+    }
+    this->_out[source].push_back(vtx);
+    this->_in[target].push_back(utx);
+    const auto lower = this->_order[target];
+    const auto upper = this->_order[source];
+    if (upper < lower) {
+        return false;
+    }
+
+    ++this->_reorders;
+    if (++this->_stamp == 0) {
+        std::fill(this->_forward_seen.begin(), this->_forward_seen.end(), 0);
+        std::fill(this->_backward_seen.begin(), this->_backward_seen.end(), 0);
+        this->_stamp = 1;
+    }
+    this->_search(target, true, upper);
+    this->_search(source, false, lower);
+
+    // The positions of the components found are handed out again among them.
+    auto slots = std::vector<uint32_t>{};
+    auto before = std::vector<uint32_t>{};  // reaching the source only
+    auto after = std::vector<uint32_t>{};   // reachable from the target only
+    auto cycle = std::vector<uint32_t>{};   // both, i.e. on a new cycle through the edge
+    for (const auto comp : this->_backward) {
+        slots.push_back(this->_order[comp]);
+        if (this->_forward_seen[comp] != this->_stamp) {
+            before.push_back(comp);
+        }
+    }
+    for (const auto comp : this->_forward) {
+        if (this->_backward_seen[comp] != this->_stamp) {
+            slots.push_back(this->_order[comp]);
+            after.push_back(comp);
+        } else {
+            cycle.push_back(comp);
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+    const auto by_order
+        = [this](uint32_t lhs, uint32_t rhs) { return this->_order[lhs] < this->_order[rhs]; };
+    std::sort(before.begin(), before.end(), by_order);
+    std::sort(after.begin(), after.end(), by_order);
+
+    // Those reaching the source take the lowest, those reachable from the
+    // target the highest, and a merged component the first one left between.
+    for (size_t i = 0; i != before.size(); ++i) {
+        this->_order[before[i]] = slots[i];
+    }
+    const auto skip = slots.size() - after.size();
+    for (size_t i = 0; i != after.size(); ++i) {
+        this->_order[after[i]] = slots[skip + i];
+    }
+    if (cycle.empty()) {
+        return false;
+    }
+    this->_merge(cycle, slots[before.size()]);
+    return true;
+}
+
+auto IncrementalScc::add_edges(std::span<const uint32_t> source,
+                               std::span<const uint32_t> target) -> size_t {
+    if (source.size() != target.size()) {
+        throw std::invalid_argument("IncrementalScc::add_edges: source and target sizes differ");
+    }
+    const auto count = this->_count;
+    for (size_t i = 0; i != source.size(); ++i) {
+        this->add_edge(source[i], target[i]);
+    }
+    return count - this->_count;
+}
+
+auto IncrementalScc::components() const -> Components {
+    auto result = Components{};
+    result.component.assign(this->num_nodes(), none);
+    auto number = std::vector<uint32_t>(this->num_nodes(), none);
+    for (uint32_t vtx = 0; vtx != this->num_nodes(); ++vtx) {
+        auto &comp = number[this->find(vtx)];
+        if (comp == none) {
+            comp = result.count++;
+        }
+        result.component[vtx] = comp;
+    }
+    return result;
+}
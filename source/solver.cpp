@@ -0,0 +1,306 @@
+#include <fmt/format.h>
+
+#include <algorithm>  // for reverse, max, min
+#include <atomic>
+#include <chrono>
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/min_cycle_ratio.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <digraphx/scc.hpp>
+#include <digraphx/solver.hpp>
+#include <exception>  // for exception_ptr, current_exception, rethrow_exception
+#include <stdexcept>  // for invalid_argument
+#include <thread>
+
+using namespace digraphx;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    auto elapsed_ms(Clock::time_point start) -> double {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Stores a cycle reported by the solvers in traversal order
+     *
+     * The solvers list the edges of a cycle by walking the predecessor
+     * pointers, i.e. backwards.
+     */
+    void set_cycle(SolveResult &result, const GraphData &gra, std::vector<uint32_t> cycle) {
+        std::reverse(cycle.begin(), cycle.end());
+        result.has_cycle = !cycle.empty();
+        result.cycle_nodes.clear();
+        for (const auto edge : cycle) {
+            result.cycle_nodes.push_back(gra.source[edge]);
+        }
+        result.cycle_edges = std::move(cycle);
+    }
+
+    auto cycle_search(Engine engine) -> CycleSearch {
+        return engine == Engine::Admissible ? CycleSearch::Admissible : CycleSearch::Policy;
+    }
+
+    /** A graph to solve, its CSR form and the edge costs of the query */
+    struct Instance {
+        const GraphData &gra;
+        const CsrGraph &csr;
+        std::span<const double> cost;
+    };
+
+    void solve_neg_cycle(const Instance &inst, const SolveOptions &options,
+                         std::span<const double> weight, SolveWorkspace &work,
+                         SolveResult &result) {
+        auto &dist = work.dist;
+        auto ncf = NegCycleFinder<CsrGraph>(inst.csr);
+        ncf.set_relax_options(options.relax);
+        ncf.set_cycle_search(cycle_search(options.engine));
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights<double>(weight))) {
+            set_cycle(result, inst.gra, cycle);
+            break;
+        }
+        for (const auto edge : result.cycle_edges) {
+            result.value += weight[edge];
+        }
+    }
+
+    void solve_cycle_ratio(const Instance &inst, const SolveOptions &options,
+                           SolveWorkspace &work, bool unit_time, SolveResult &result) {
+        const auto &gra = inst.gra;
+        if (!unit_time && !gra.has_time()) {
+            throw std::invalid_argument("cycle ratio problem needs a time for every edge");
+        }
+        // Any cycle ratio is bounded by the largest edge ratio, so starting just
+        // above it guarantees that the first round sees every critical cycle.
+        auto r_max = 0.0;
+        for (size_t i = 0; i != gra.num_edges(); ++i) {
+            const auto time = unit_time ? 1.0 : gra.time[i];
+            if (time <= 0.0) {
+                throw std::invalid_argument(fmt::format("edge {} has non-positive time", i));
+            }
+            r_max = i == 0 ? inst.cost[i] / time : std::max(r_max, inst.cost[i] / time);
+        }
+        auto ratio = r_max + 1.0;
+        auto &dist = work.dist;
+        if (unit_time) {
+            work.time.assign(gra.num_edges(), 1.0);
+        }
+        auto cycle = min_cycle_ratio_csr<double>(
+            inst.csr, ratio, inst.cost, unit_time ? work.time : gra.time, dist, options.relax,
+            cycle_search(options.engine));
+        set_cycle(result, gra, std::move(cycle));
+        if (result.has_cycle) {
+            result.value = ratio;
+        }
+    }
+
+    /**
+     * @brief Solves the problem on the edges within strongly connected components only
+     *
+     * The other edges are on no cycle, so dropping them changes neither the
+     * negative cycles nor the cycle ratios, and makes every pass cheaper.
+     */
+    auto solve_pruned(const GraphData &gra, const SolveOptions &options, SolveWorkspace &work)
+        -> SolveResult {
+        if (options.problem == Problem::CycleRatio && !gra.has_time()) {
+            throw std::invalid_argument("cycle ratio problem needs a time for every edge");
+        }
+        const auto start = Clock::now();
+        work.csr.assign(gra.num_nodes, gra.source, gra.target);
+        const auto scc
+            = strongly_connected_components(work.csr, SccOptions{.threads = options.relax.threads});
+        const auto kept = cyclic_edges(work.csr, scc);
+        auto sub = GraphData{};
+        sub.num_nodes = gra.num_nodes;
+        sub.source.reserve(kept.size());
+        sub.target.reserve(kept.size());
+        sub.cost.reserve(kept.size());
+        for (const auto edge : kept) {
+            sub.source.push_back(gra.source[edge]);
+            sub.target.push_back(gra.target[edge]);
+            sub.cost.push_back(gra.cost[edge]);
+            if (gra.has_time()) {
+                sub.time.push_back(gra.time[edge]);
+            }
+        }
+        const auto prune_ms = elapsed_ms(start);
+        if (kept.empty()) {
+            auto result = SolveResult{};
+            result.build_ms = prune_ms;
+            return result;
+        }
+
+        auto inner = options;
+        inner.prune = false;
+        auto result = solve(sub, inner, work);
+        for (auto &edge : result.cycle_edges) {
+            edge = kept[edge];
+        }
+        result.build_ms += prune_ms;
+        return result;
+    }
+
+}  // namespace
+
+auto digraphx::parse_problem(std::string_view name) -> Problem {
+    if (name == "negcycle") {
+        return Problem::NegCycle;
+    }
+    if (name == "ratio") {
+        return Problem::CycleRatio;
+    }
+    if (name == "mean") {
+        return Problem::MeanCycle;
+    }
+    throw std::invalid_argument(fmt::format("unknown problem '{}'", name));
+}
+
+auto digraphx::parse_engine(std::string_view name) -> Engine {
+    if (name == "howard") {
+        return Engine::Howard;
+    }
+    if (name == "admissible") {
+        return Engine::Admissible;
+    }
+    throw std::invalid_argument(fmt::format("unknown engine '{}'", name));
+}
+
+auto digraphx::to_string(Problem problem) -> std::string_view {
+    switch (problem) {
+        case Problem::CycleRatio:
+            return "ratio";
+        case Problem::MeanCycle:
+            return "mean";
+        default:
+        case Problem::NegCycle:
+            return "negcycle";
+    }
+}
+
+auto digraphx::to_string(Engine engine) -> std::string_view {
+    switch (engine) {
+        case Engine::Admissible:
+            return "admissible";
+        default:
+        case Engine::Howard:
+            return "howard";
+    }
+}
+
+auto digraphx::solve(const GraphData &gra, const SolveOptions &options) -> SolveResult {
+    auto workspace = SolveWorkspace{};
+    return solve(gra, options, workspace);
+}
+
+/**
+ * The function builds a CSR view of `gra` in the workspace and runs the solver
+ * selected by `options` on it, starting from the all-zero potential.
+ */
+auto digraphx::solve(const GraphData &gra, const SolveOptions &options, SolveWorkspace &workspace)
+    -> SolveResult {
+    if (options.prune) {
+        return solve_pruned(gra, options, workspace);
+    }
+    auto result = SolveResult{};
+    auto start = Clock::now();
+    workspace.csr.assign(gra.num_nodes, gra.source, gra.target);
+    workspace.dist.assign(gra.num_nodes, 0.0);
+    result.build_ms = elapsed_ms(start);
+
+    start = Clock::now();
+    const auto inst = Instance{gra, workspace.csr, gra.cost};
+    switch (options.problem) {
+        case Problem::CycleRatio:
+            solve_cycle_ratio(inst, options, workspace, false, result);
+            break;
+        case Problem::MeanCycle:
+            solve_cycle_ratio(inst, options, workspace, true, result);
+            break;
+        default:
+        case Problem::NegCycle:
+            solve_neg_cycle(inst, options, gra.cost, workspace, result);
+            break;
+    }
+    result.solve_ms = elapsed_ms(start);
+    return result;
+}
+
+SharedGraph::SharedGraph(GraphData gra)
+    : _data{std::move(gra)},
+      _csr(this->_data.num_nodes, this->_data.source, this->_data.target),
+      _transpose(this->_csr) {}
+
+auto digraphx::solve(const SharedGraph &gra, const Query &query, SolveWorkspace &workspace)
+    -> SolveResult {
+    const auto &data = gra.data();
+    if (!query.cost.empty() && query.cost.size() != data.num_edges()) {
+        throw std::invalid_argument(fmt::format("query has {} costs for {} edges",
+                                                query.cost.size(), data.num_edges()));
+    }
+    auto options = query.options;
+    options.relax.transpose = &gra.transpose();
+    const auto inst = Instance{data, gra.csr(), query.cost.empty() ? data.cost : query.cost};
+
+    auto result = SolveResult{};
+    const auto start = Clock::now();
+    workspace.dist.assign(data.num_nodes, 0.0);
+    switch (options.problem) {
+        case Problem::CycleRatio:
+            solve_cycle_ratio(inst, options, workspace, false, result);
+            break;
+        case Problem::MeanCycle:
+            solve_cycle_ratio(inst, options, workspace, true, result);
+            break;
+        default:
+        case Problem::NegCycle:
+            if (query.ratio == 0.0) {
+                solve_neg_cycle(inst, options, inst.cost, workspace, result);
+                break;
+            }
+            if (!data.has_time()) {
+                throw std::invalid_argument("target ratio query needs a time for every edge");
+            }
+            workspace.weight.resize(data.num_edges());
+            for (size_t i = 0; i != data.num_edges(); ++i) {
+                workspace.weight[i] = inst.cost[i] - query.ratio * data.time[i];
+            }
+            solve_neg_cycle(inst, options, workspace.weight, workspace, result);
+            break;
+    }
+    result.solve_ms = elapsed_ms(start);
+    return result;
+}
+
+auto digraphx::solve_all(const SharedGraph &gra, std::span<const Query> queries, size_t threads)
+    -> std::vector<SolveResult> {
+    auto results = std::vector<SolveResult>(queries.size());
+    auto errors = std::vector<std::exception_ptr>(queries.size());
+    auto next = std::atomic<size_t>{0};
+    auto worker = [&]() {
+        auto workspace = SolveWorkspace{};
+        for (auto idx = next++; idx < queries.size(); idx = next++) {
+            try {
+                results[idx] = solve(gra, queries[idx], workspace);
+            } catch (...) {
+                errors[idx] = std::current_exception();
+            }
+        }
+    };
+
+    threads = std::max<size_t>(1, std::min(threads, queries.size()));
+    auto pool = std::vector<std::thread>{};
+    for (size_t i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
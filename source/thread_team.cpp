@@ -0,0 +1,43 @@
+#include <ThreadPool.h>  // for ThreadPool
+#include <digraphx/thread_team.hpp>
+#include <utility>  // for exchange, move
+
+using namespace digraphx;
+
+ThreadTeam::ThreadTeam() = default;
+
+ThreadTeam::ThreadTeam(const ThreadTeam & /* other */) : ThreadTeam() {}
+
+ThreadTeam::ThreadTeam(ThreadTeam &&other) noexcept
+    : _pool{std::move(other._pool)}, _size{std::exchange(other._size, 0)} {}
+
+auto ThreadTeam::operator=(const ThreadTeam &other) -> ThreadTeam & {
+    if (this != &other) {
+        this->_pool.reset();
+        this->_size = 0;
+    }
+    return *this;
+}
+
+auto ThreadTeam::operator=(ThreadTeam &&other) noexcept -> ThreadTeam & {
+    if (this != &other) {
+        this->_pool = std::move(other._pool);
+        this->_size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+ThreadTeam::~ThreadTeam() = default;
+
+/** Restarts the pool with `threads` threads if it has fewer */
+void ThreadTeam::_reserve(size_t threads) {
+    if (this->_size < threads) {
+        this->_pool.reset();
+        this->_pool = std::make_unique<ThreadPool>(threads);
+        this->_size = threads;
+    }
+}
+
+auto ThreadTeam::_enqueue(std::function<void()> task) -> std::future<void> {
+    return this->_pool->enqueue(std::move(task));
+}
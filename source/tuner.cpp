@@ -0,0 +1,241 @@
+#include <fmt/format.h>
+
+#include <algorithm>  // for max, min
+#include <bit>        // for bit_width
+#include <chrono>
+#include <cmath>  // for log2, lround
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <digraphx/scc.hpp>
+#include <digraphx/tuner.hpp>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>  // for runtime_error
+#include <vector>
+
+using namespace digraphx;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /** Edges between node ids closer than this count as local */
+    constexpr uint32_t local_span = 4096;
+
+    /** Graphs with fewer edges are solved in about the time a thread takes to start */
+    constexpr size_t large_graph = size_t(1) << 20;
+
+    /** Bucket of a fraction in `0..steps` */
+    auto bucket(double fraction, int steps) -> long { return std::lround(fraction * steps); }
+
+    /** The relaxation modes tried on one thread, and those also tried on several */
+    constexpr RelaxMode serial_modes[] = {RelaxMode::Sweep,  RelaxMode::Adaptive,
+                                          RelaxMode::Blocked, RelaxMode::Deque,
+                                          RelaxMode::Threshold, RelaxMode::Delta};
+    constexpr RelaxMode parallel_modes[]
+        = {RelaxMode::Adaptive, RelaxMode::Async, RelaxMode::Delta};
+
+    auto table_key(const std::string &family, Problem problem) -> std::string {
+        return fmt::format("{} {}", family, to_string(problem));
+    }
+
+}  // namespace
+
+auto digraphx::profile_graph(const GraphData &gra) -> GraphProfile {
+    auto profile = GraphProfile{};
+    profile.num_nodes = gra.num_nodes;
+    profile.num_edges = gra.num_edges();
+    if (gra.num_nodes == 0) {
+        return profile;
+    }
+    profile.mean_degree = double(profile.num_edges) / double(profile.num_nodes);
+
+    auto out_degree = std::vector<size_t>(gra.num_nodes, 0);
+    auto in_degree = std::vector<size_t>(gra.num_nodes, 0);
+    auto negative = size_t{0};
+    auto local = size_t{0};
+    for (size_t i = 0; i != profile.num_edges; ++i) {
+        const auto utx = gra.source[i];
+        const auto vtx = gra.target[i];
+        ++out_degree[utx];
+        ++in_degree[vtx];
+        negative += gra.cost[i] < 0.0 ? 1 : 0;
+        local += (utx < vtx ? vtx - utx : utx - vtx) < local_span ? 1 : 0;
+    }
+    auto max_degree = size_t{0};
+    for (size_t vtx = 0; vtx != gra.num_nodes; ++vtx) {
+        max_degree = std::max({max_degree, out_degree[vtx], in_degree[vtx]});
+    }
+    if (profile.num_edges != 0) {
+        profile.degree_skew = double(max_degree) / profile.mean_degree;
+        profile.negative_fraction = double(negative) / double(profile.num_edges);
+        profile.locality = double(local) / double(profile.num_edges);
+    }
+
+    const auto scc = strongly_connected_components(CsrGraph(gra.num_nodes, gra.source, gra.target));
+    const auto sizes = scc.sizes();
+    profile.num_sccs = sizes.size();
+    profile.largest_scc = *std::max_element(sizes.begin(), sizes.end());
+    return profile;
+}
+
+auto digraphx::graph_family(const GraphProfile &profile) -> std::string {
+    const auto coverage
+        = profile.num_nodes == 0 ? 0.0 : double(profile.largest_scc) / double(profile.num_nodes);
+    return fmt::format("n{}-d{}-s{}-c{}-g{}-l{}", std::bit_width(profile.num_nodes),
+                       std::lround(std::log2(profile.mean_degree + 1.0)),
+                       std::bit_width(size_t(profile.degree_skew)), bucket(coverage, 4),
+                       bucket(profile.negative_fraction, 4), bucket(profile.locality, 2));
+}
+
+auto AutoTuner::rules(const GraphProfile &profile, size_t max_threads) -> TuneChoice {
+    auto choice = TuneChoice{};
+    if (profile.largest_scc <= 1) {
+        choice.relax.mode = RelaxMode::Sweep;  // nothing to find but the potential
+    } else if (profile.negative_fraction < 0.1) {
+        choice.relax.mode = RelaxMode::Deque;
+    } else if (profile.num_edges >= large_graph && max_threads > 1) {
+        choice.relax.mode = RelaxMode::Adaptive;
+        choice.relax.threads = max_threads;
+    } else if (profile.num_edges >= large_graph && profile.locality >= 0.75) {
+        choice.relax.mode = RelaxMode::Blocked;
+    } else {
+        choice.relax.mode = RelaxMode::Adaptive;
+    }
+    return choice;
+}
+
+/**
+ * The function times the first round of `solve` with `choice`: `howard` on the
+ * costs for a negative cycle, and on the parametric weights `cost - r * time`
+ * of the first ratio `r` above every edge ratio otherwise, stopping at the
+ * first cycle or after `trial_passes` passes.
+ */
+auto AutoTuner::_trial(const GraphData &gra, Problem problem, const TuneChoice &choice) const
+    -> double {
+    auto weight = gra.cost;
+    if (problem != Problem::NegCycle) {
+        const auto unit_time = problem == Problem::MeanCycle || !gra.has_time();
+        auto r_max = 0.0;
+        for (size_t i = 0; i != gra.num_edges(); ++i) {
+            const auto time = unit_time ? 1.0 : gra.time[i];
+            r_max = i == 0 ? weight[i] / time : std::max(r_max, weight[i] / time);
+        }
+        for (size_t i = 0; i != gra.num_edges(); ++i) {
+            weight[i] -= (r_max + 1.0) * (unit_time ? 1.0 : gra.time[i]);
+        }
+    }
+    const auto csr = CsrGraph(gra.num_nodes, gra.source, gra.target);
+    auto dist = std::vector<double>(gra.num_nodes, 0.0);
+    auto ncf = NegCycleFinder<CsrGraph>(csr);
+    ncf.set_relax_options(choice.relax);
+    ncf.set_cycle_search(choice.engine == Engine::Admissible ? CycleSearch::Admissible
+                                                             : CycleSearch::Policy);
+    ncf.set_max_passes(this->_options.trial_passes);
+
+    const auto start = Clock::now();
+    for ([[maybe_unused]] const auto &cycle : ncf.howard(dist, EdgeWeights<double>(weight))) {
+        break;
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * The function profiles `gra` outside the lock, so concurrent callers only
+ * wait for each other while looking the table up and storing a choice. Two
+ * callers missing the same family may both tune it; the last one wins.
+ */
+auto AutoTuner::choose(const GraphData &gra, Problem problem) -> TuneChoice {
+    const auto profile = profile_graph(gra);
+    const auto key = table_key(graph_family(profile), problem);
+    {
+        const auto lock = std::scoped_lock(this->_mutex);
+        const auto found = this->_table.find(key);
+        if (found != this->_table.end()) {
+            return found->second;
+        }
+    }
+
+    auto choice = rules(profile, this->_options.max_threads);
+    if (this->_options.trials) {
+        auto candidates = std::vector<TuneChoice>{};
+        for (const auto engine : {Engine::Howard, Engine::Admissible}) {
+            for (const auto mode : serial_modes) {
+                candidates.push_back({engine, RelaxOptions{.mode = mode}});
+            }
+            if (this->_options.max_threads > 1) {
+                for (const auto mode : parallel_modes) {
+                    const auto relax
+                        = RelaxOptions{.mode = mode, .threads = this->_options.max_threads};
+                    candidates.push_back({engine, relax});
+                }
+            }
+        }
+        choice.trial_ms = -1.0;
+        for (auto &candidate : candidates) {
+            candidate.trial_ms = this->_trial(gra, problem, candidate);
+            if (choice.trial_ms < 0.0 || candidate.trial_ms < choice.trial_ms) {
+                choice = candidate;
+            }
+        }
+    }
+
+    const auto lock = std::scoped_lock(this->_mutex);
+    this->_table[key] = choice;
+    return choice;
+}
+
+auto AutoTuner::tune(const GraphData &gra, const SolveOptions &base) -> SolveOptions {
+    const auto choice = this->choose(gra, base.problem);
+    auto options = base;
+    options.engine = choice.engine;
+    options.relax.mode = choice.relax.mode;
+    options.relax.threads = choice.relax.threads;
+    return options;
+}
+
+void AutoTuner::read_table(std::istream &input) {
+    auto line = std::string{};
+    for (size_t lineno = 1; std::getline(input, line); ++lineno) {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        auto fields = std::istringstream(line);
+        auto family = std::string{};
+        auto problem = std::string{};
+        auto engine = std::string{};
+        auto mode = std::string{};
+        auto threads = size_t{0};
+        if (!(fields >> family >> problem >> engine >> mode >> threads) || threads == 0) {
+            throw std::runtime_error(
+                fmt::format("line {}: expected 'family problem engine mode threads'", lineno));
+        }
+        auto choice = TuneChoice{};
+        try {
+            choice.engine = parse_engine(engine);
+            choice.relax.mode = parse_relax_mode(mode);
+            choice.relax.threads = threads;
+            const auto key = table_key(family, parse_problem(problem));
+            const auto lock = std::scoped_lock(this->_mutex);
+            this->_table[key] = choice;
+        } catch (const std::invalid_argument &error) {
+            throw std::runtime_error(fmt::format("line {}: {}", lineno, error.what()));
+        }
+    }
+}
+
+void AutoTuner::write_table(std::ostream &output) const {
+    const auto lock = std::scoped_lock(this->_mutex);
+    output << "# family problem engine mode threads\n";
+    for (const auto &[key, choice] : this->_table) {
+        output << fmt::format("{} {} {} {}\n", key, to_string(choice.engine),
+                              to_string(choice.relax.mode), choice.relax.threads);
+    }
+}
+
+auto AutoTuner::size() const -> size_t {
+    const auto lock = std::scoped_lock(this->_mutex);
+    return this->_table.size();
+}
@@ -1,52 +1,197 @@
-#include <digraphx/greeter.h>  // for LanguageCode, LanguageCode::DE, Langua...
+#include <ThreadPool.h>          // for ThreadPool
+#include <digraphx/graph_io.hpp>  // for read_graph, GraphFormat, GraphData
+#include <digraphx/solver.hpp>    // for solve, SolveOptions
+#include <digraphx/tuner.hpp>     // for AutoTuner
 
+#include <algorithm>      // for max
+#include <chrono>         // for steady_clock
 #include <cxxopts.hpp>    // for value, OptionAdder, Options, OptionValue
-#include <iostream>       // for string, operator<<, endl, basic_ostream
-#include <string>         // for char_traits, hash, operator==
-#include <unordered_map>  // for operator==, unordered_map, __hash_map_...
-
-auto main(int argc, char** argv) -> int {
-    const std::unordered_map<std::string, digraphx::LanguageCode> languages{
-        {"en", digraphx::LanguageCode::EN},
-        {"de", digraphx::LanguageCode::DE},
-        {"es", digraphx::LanguageCode::ES},
-        {"fr", digraphx::LanguageCode::FR},
+#include <exception>      // for exception
+#include <fstream>        // for ifstream, ofstream
+#include <future>         // for future
+#include <iostream>       // for cin, cout, cerr
+#include <optional>       // for optional
+#include <stdexcept>      // for runtime_error
+#include <string>         // for string
+#include <vector>         // for vector
+
+#include "report.hpp"  // for Report, format_report, format_error
+#include "server.hpp"  // for serve_stdio, serve_unix_socket
+
+namespace {
+
+    struct Job {
+        std::string output;
+        bool failed{false};
     };
 
-    cxxopts::Options options(*argv, "A program to welcome the world!");
+    /**
+     * @brief Loads and solves one input, `-` being the standard input
+     *
+     * With a `tuner` the engine and relaxation of `options` are replaced by
+     * those it chooses for the graph.
+     */
+    auto run_job(const std::string &path, std::optional<digraphx::GraphFormat> format,
+                 const digraphx::SolveOptions &options, OutputFormat style,
+                 digraphx::AutoTuner *tuner) -> Job {
+        try {
+            const auto fmt = format ? *format : digraphx::guess_graph_format(path);
+            const auto start = std::chrono::steady_clock::now();
+            const auto gra = path == "-" ? digraphx::read_graph(std::cin, fmt)
+                                         : digraphx::read_graph_file(path, fmt);
+            auto report = Report{};
+            report.load_ms = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+            report.name = path;
+            report.num_nodes = gra.num_nodes;
+            report.num_edges = gra.num_edges();
+            report.node_base = fmt == digraphx::GraphFormat::Dimacs ? 1 : 0;
+            report.options = tuner != nullptr ? tuner->tune(gra, options) : options;
+            report.result = digraphx::solve(gra, report.options);
+            return {format_report(report, style), false};
+        } catch (const std::exception &err) {
+            return {format_error(path, err.what(), style), true};
+        }
+    }
+
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+    cxxopts::Options options(*argv, "Negative cycle and minimum cycle ratio solver");
 
-    std::string language;
-    std::string name;
+    std::vector<std::string> inputs;
+    std::string problem;
+    std::string engine;
+    std::string format;
+    std::string output;
+    std::string socket;
+    std::string relax;
+    std::string tuning_table;
+    size_t threads = 1;
+    size_t relax_threads = 1;
+    size_t max_pending = 0;
+    size_t max_frame = 64;
+    size_t max_nodes = size_t(1) << 24U;
 
     // clang-format off
   options.add_options()
     ("h,help", "Show help")
-    ("v,version", "Print the current version number")
-    ("n,name", "Name to greet", cxxopts::value(name)->default_value("World"))
-    ("l,lang", "Language code to use", cxxopts::value(language)->default_value("en"))
+    ("p,problem", "Problem to solve: negcycle, ratio or mean",
+     cxxopts::value(problem)->default_value("negcycle"))
+    ("e,engine", "Negative cycle engine: howard or admissible",
+     cxxopts::value(engine)->default_value("howard"))
+    ("relax", "Relaxation mode: sweep, pushpull, blocked, async, delta, deque, threshold or "
+     "adaptive", cxxopts::value(relax)->default_value("sweep"))
+    ("relax-threads", "Threads of the parallel relaxation modes",
+     cxxopts::value(relax_threads)->default_value("1"))
+    ("prune", "Drop the edges between strongly connected components before solving")
+    ("tune", "Choose the engine and relaxation of each input by timing brief trial solves")
+    ("tuning-table", "Tuning table to read, and to write back after --tune",
+     cxxopts::value(tuning_table))
+    ("f,format", "Input format: auto, dimacs, edgelist or binary",
+     cxxopts::value(format)->default_value("auto"))
+    ("o,output", "Output format: text or json", cxxopts::value(output)->default_value("text"))
+    ("j,threads", "Number of input files or requests solved concurrently",
+     cxxopts::value(threads)->default_value("1"))
+    ("serve", "Serve length-prefixed requests from the standard input")
+    ("socket", "Serve length-prefixed requests on a Unix domain socket", cxxopts::value(socket))
+    ("tagged", "Server: write responses as they complete instead of in request order")
+    ("max-pending", "Server: requests read ahead of their responses (0: 4 per thread)",
+     cxxopts::value(max_pending)->default_value("0"))
+    ("max-frame", "Server: largest request in MiB; a larger one ends the connection",
+     cxxopts::value(max_frame)->default_value("64"))
+    ("max-nodes", "Server: largest graph of a request in nodes; a larger one is an error",
+     cxxopts::value(max_nodes)->default_value("16777216"))
+    ("inputs", "Graph files, '-' for the standard input", cxxopts::value(inputs))
   ;
     // clang-format on
+    options.parse_positional({"inputs"});
+    options.positional_help("FILE...");
 
-    auto result = options.parse(argc, argv);
-
-    if (result["help"].as<bool>()) {
-        std::cout << options.help() << std::endl;
-        return 0;
+    auto solve_options = digraphx::SolveOptions{};
+    auto graph_format = std::optional<digraphx::GraphFormat>{};
+    auto style = OutputFormat::Text;
+    auto server_mode = false;
+    auto tagged = false;
+    auto tuning = false;
+    auto tuner = std::optional<digraphx::AutoTuner>{};
+    try {
+        auto result = options.parse(argc, argv);
+        server_mode = result["serve"].as<bool>() || result.count("socket") != 0;
+        tagged = result["tagged"].as<bool>();
+        if (result["help"].as<bool>() || (inputs.empty() && !server_mode)) {
+            std::cout << options.help() << std::endl;
+            return 0;
+        }
+        solve_options.problem = digraphx::parse_problem(problem);
+        solve_options.engine = digraphx::parse_engine(engine);
+        solve_options.relax.mode = digraphx::parse_relax_mode(relax);
+        solve_options.relax.threads = std::max<size_t>(relax_threads, 1);
+        solve_options.prune = result["prune"].as<bool>();
+        tuning = result["tune"].as<bool>();
+        if (tuning || !tuning_table.empty()) {
+            tuner.emplace(digraphx::TunerOptions{.trials = tuning,
+                                                 .max_threads = solve_options.relax.threads});
+        }
+        if (!tuning_table.empty()) {
+            auto table = std::ifstream(tuning_table);
+            if (table) {
+                tuner->read_table(table);
+            } else if (!tuning) {
+                throw std::runtime_error("cannot open tuning table " + tuning_table);
+            }
+        }
+        if (format != "auto") {
+            graph_format = digraphx::parse_graph_format(format);
+        }
+        style = parse_output_format(output);
+    } catch (const std::exception &err) {
+        std::cerr << err.what() << std::endl;
+        return 2;
     }
 
-    // if (result["version"].as<bool>()) {
-    //     std::cout << "DiGraphX, version " << DIGRAPHX_VERSION << std::endl;
-    //     return 0;
-    // }
-
-    auto langIt = languages.find(language);
-    if (langIt == languages.end()) {
-        std::cerr << "unknown language code: " << language << std::endl;
-        return 1;
+    if (server_mode) {
+        auto server = ServerOptions{};
+        server.threads = std::max<size_t>(threads, 1);
+        server.max_pending = max_pending;
+        server.max_frame = max_frame << 20U;
+        server.max_nodes = max_nodes;
+        server.tagged = tagged;
+        server.style = style;
+        server.defaults = solve_options;
+        server.format = graph_format.value_or(digraphx::GraphFormat::EdgeList);
+        return socket.empty() ? serve_stdio(server) : serve_unix_socket(socket, server);
     }
 
-    digraphx::DiGraphX digraphx(name);
-    std::cout << digraphx.greet(langIt->second) << std::endl;
+    auto pool = ThreadPool(std::max<size_t>(threads, 1));
+    auto jobs = std::vector<std::future<Job>>{};
+    for (const auto &path : inputs) {
+        jobs.push_back(pool.enqueue(run_job, path, graph_format, solve_options, style,
+                                    tuner ? &*tuner : nullptr));
+    }
 
-    return 0;
+    auto status = 0;
+    for (auto &job : jobs) {
+        const auto done = job.get();
+        if (done.failed) {
+            status = 1;
+            (style == OutputFormat::Json ? std::cout : std::cerr) << done.output;
+        } else {
+            std::cout << done.output;
+        }
+        if (style == OutputFormat::Json) {
+            std::cout << '\n';
+        }
+        std::cout.flush();
+    }
+    if (tuning && !tuning_table.empty()) {
+        auto table = std::ofstream(tuning_table);
+        tuner->write_table(table);
+        if (!table) {
+            std::cerr << "cannot write tuning table " << tuning_table << std::endl;
+            return 1;
+        }
+    }
+    return status;
 }
@@ -0,0 +1,121 @@
+#include "report.hpp"
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>  // for join
+
+#include <cmath>      // for isfinite
+#include <stdexcept>  // for invalid_argument
+
+namespace {
+
+    auto json_string(std::string_view text) -> std::string {
+        auto out = std::string{"\""};
+        for (const auto chr : text) {
+            switch (chr) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(chr) < 0x20) {
+                        out += fmt::format("\\u{:04x}", int(chr));
+                    } else {
+                        out += chr;
+                    }
+            }
+        }
+        return out + '"';
+    }
+
+    /** JSON has no infinity or NaN, so a value that is not finite is written as `null` */
+    auto json_number(double value) -> std::string {
+        return std::isfinite(value) ? fmt::format("{}", value) : std::string{"null"};
+    }
+
+    auto shifted(const std::vector<uint32_t> &ids, uint32_t base) -> std::vector<uint64_t> {
+        auto out = std::vector<uint64_t>{};
+        out.reserve(ids.size());
+        for (const auto idx : ids) {
+            out.push_back(uint64_t(idx) + base);
+        }
+        return out;
+    }
+
+    auto format_json(const Report &report) -> std::string {
+        const auto &res = report.result;
+        auto out = fmt::format(
+            R"({{"name":{},"problem":"{}","engine":"{}","relax":"{}","relax_threads":{},)"
+            R"("nodes":{},"edges":{},"cycle_found":{})",
+            json_string(report.name), digraphx::to_string(report.options.problem),
+            digraphx::to_string(report.options.engine),
+            digraphx::to_string(report.options.relax.mode), report.options.relax.threads,
+            report.num_nodes, report.num_edges, res.has_cycle);
+        if (res.has_cycle) {
+            out += fmt::format(R"(,"value":{},"cycle_nodes":[{}],"cycle_edges":[{}])",
+                               json_number(res.value),
+                               fmt::join(shifted(res.cycle_nodes, report.node_base), ","),
+                               fmt::join(res.cycle_edges, ","));
+        }
+        out += fmt::format(R"(,"load_ms":{:.3f},"build_ms":{:.3f},"solve_ms":{:.3f}}})",
+                           report.load_ms, res.build_ms, res.solve_ms);
+        return out;
+    }
+
+    auto format_text(const Report &report) -> std::string {
+        const auto &res = report.result;
+        auto out = fmt::format("{}: {} nodes, {} edges\n", report.name, report.num_nodes,
+                               report.num_edges);
+        out += fmt::format("  problem: {} (engine {}, relax {} x{})\n",
+                           digraphx::to_string(report.options.problem),
+                           digraphx::to_string(report.options.engine),
+                           digraphx::to_string(report.options.relax.mode),
+                           report.options.relax.threads);
+        if (!res.has_cycle) {
+            out += report.options.problem == digraphx::Problem::NegCycle
+                       ? "  no negative cycle\n"
+                       : "  no cycle\n";
+        } else {
+            const auto *label
+                = report.options.problem == digraphx::Problem::NegCycle ? "weight" : "ratio";
+            const auto nodes = shifted(res.cycle_nodes, report.node_base);
+            out += fmt::format("  {}: {}\n", label, res.value);
+            out += fmt::format("  cycle ({} edges): {} -> {}\n", res.cycle_edges.size(),
+                               fmt::join(nodes, " -> "), nodes.front());
+        }
+        out += fmt::format("  time: load {:.3f} ms, build {:.3f} ms, solve {:.3f} ms\n",
+                           report.load_ms, res.build_ms, res.solve_ms);
+        return out;
+    }
+
+}  // namespace
+
+auto parse_output_format(std::string_view name) -> OutputFormat {
+    if (name == "text") {
+        return OutputFormat::Text;
+    }
+    if (name == "json") {
+        return OutputFormat::Json;
+    }
+    throw std::invalid_argument(fmt::format("unknown output format '{}'", name));
+}
+
+auto format_report(const Report &report, OutputFormat style) -> std::string {
+    return style == OutputFormat::Json ? format_json(report) : format_text(report);
+}
+
+auto format_error(std::string_view name, std::string_view message, OutputFormat style)
+    -> std::string {
+    if (style == OutputFormat::Json) {
+        return fmt::format(R"({{"name":{},"error":{}}})", json_string(name),
+                           json_string(message));
+    }
+    return fmt::format("{}: error: {}\n", name, message);
+}
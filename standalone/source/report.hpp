@@ -0,0 +1,39 @@
+#pragma once
+
+#include <digraphx/solver.hpp>  // for SolveOptions, SolveResult
+#include <string>
+#include <string_view>
+
+/** Output styles of the command line tool */
+enum class OutputFormat { Text, Json };
+
+/**
+ * @brief Everything printed about one solved graph
+ */
+struct Report {
+    std::string name;        ///< file name or request tag
+    size_t num_nodes{0};
+    size_t num_edges{0};
+    uint32_t node_base{0};   ///< added to node ids on output (1 for DIMACS input)
+    double load_ms{0.0};
+    digraphx::SolveOptions options{};
+    digraphx::SolveResult result{};
+};
+
+/**
+ * @brief Parses an output style name (`text` or `json`)
+ *
+ * @exception std::invalid_argument for an unknown name
+ */
+auto parse_output_format(std::string_view name) -> OutputFormat;
+
+/**
+ * @brief Formats a report; JSON reports are a single line without a trailing newline
+ */
+auto format_report(const Report &report, OutputFormat style) -> std::string;
+
+/**
+ * @brief Formats a failure for `name`; JSON errors are a single line without a trailing newline
+ */
+auto format_error(std::string_view name, std::string_view message, OutputFormat style)
+    -> std::string;
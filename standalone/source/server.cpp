@@ -0,0 +1,324 @@
+#include "server.hpp"
+
+#include <ThreadPool.h>  // for ThreadPool
+
+#include <algorithm>  // for min
+#include <array>
+#include <chrono>              // for steady_clock
+#include <condition_variable>  // for condition_variable
+#include <cstdint>             // for uint32_t
+#include <cstdio>              // for perror
+#include <deque>
+#include <exception>  // for exception
+#include <future>     // for future
+#include <iostream>   // for cerr
+#include <mutex>
+#include <semaphore>  // for counting_semaphore
+#include <sstream>    // for istringstream
+#include <stdexcept>  // for runtime_error
+#include <string>     // for to_string
+#include <string_view>
+#include <thread>
+
+#ifdef _WIN32
+#    include <fcntl.h>  // for _O_BINARY
+#    include <io.h>     // for _read, _write, _setmode
+#else
+#    include <sys/socket.h>  // for socket, bind, listen, accept
+#    include <sys/stat.h>    // for lstat, S_ISSOCK
+#    include <sys/un.h>      // for sockaddr_un
+#    include <unistd.h>      // for read, write, close, unlink
+
+#    include <cerrno>   // for errno, EINTR
+#    include <csignal>  // for signal, SIGPIPE
+#endif
+
+namespace {
+
+    auto raw_read(int fd, char *buf, size_t len) -> long {
+#ifdef _WIN32
+        return ::_read(fd, buf, static_cast<unsigned>(len));
+#else
+        auto got = ::read(fd, buf, len);
+        while (got < 0 && errno == EINTR) {
+            got = ::read(fd, buf, len);
+        }
+        return static_cast<long>(got);
+#endif
+    }
+
+    auto raw_write(int fd, const char *buf, size_t len) -> long {
+#ifdef _WIN32
+        return ::_write(fd, buf, static_cast<unsigned>(len));
+#else
+        auto put = ::write(fd, buf, len);
+        while (put < 0 && errno == EINTR) {
+            put = ::write(fd, buf, len);
+        }
+        return static_cast<long>(put);
+#endif
+    }
+
+    /**
+     * @brief Length-prefixed frames over a pair of file descriptors
+     */
+    class FrameChannel {
+        int _in;
+        int _out;
+        size_t _max_frame;
+        std::mutex _write_mutex;
+        bool _write_failed{false};
+
+        /** Reads up to `len` bytes, returning fewer only at the end of input. */
+        auto _read_exact(char *buf, size_t len) -> size_t {
+            auto done = size_t{0};
+            while (done != len) {
+                const auto got = raw_read(this->_in, buf + done, len - done);
+                if (got <= 0) {
+                    if (got < 0) {
+                        throw std::runtime_error("read error");
+                    }
+                    break;
+                }
+                done += size_t(got);
+            }
+            return done;
+        }
+
+      public:
+        FrameChannel(int in, int out, size_t max_frame)
+            : _in{in}, _out{out}, _max_frame{max_frame} {}
+
+        /**
+         * @brief Reads the next frame
+         *
+         * @return false at a clean end of input
+         * @exception std::runtime_error on a truncated frame, a frame longer than the limit,
+         * or a read error
+         */
+        auto read(std::string &payload) -> bool {
+            auto header = std::array<unsigned char, 4>{};
+            const auto got = this->_read_exact(reinterpret_cast<char *>(header.data()), 4);
+            if (got == 0) {
+                return false;
+            }
+            const auto len = uint32_t(header[0]) | uint32_t(header[1]) << 8U
+                             | uint32_t(header[2]) << 16U | uint32_t(header[3]) << 24U;
+            if (got == 4 && len > this->_max_frame) {
+                throw std::runtime_error("request frame of " + std::to_string(len)
+                                         + " bytes exceeds the limit of "
+                                         + std::to_string(this->_max_frame));
+            }
+            payload.resize(len);
+            if (got != 4 || this->_read_exact(payload.data(), len) != len) {
+                throw std::runtime_error("truncated request frame");
+            }
+            return true;
+        }
+
+        /** Writes one frame; safe to call from several threads. */
+        void write(std::string_view payload) {
+            const auto len = static_cast<uint32_t>(payload.size());
+            const auto header = std::array<char, 4>{
+                char(len & 0xFFU), char(len >> 8U & 0xFFU), char(len >> 16U & 0xFFU),
+                char(len >> 24U & 0xFFU)};
+            auto lock = std::lock_guard<std::mutex>(this->_write_mutex);
+            for (const auto part : {std::string_view(header.data(), 4), payload}) {
+                auto done = size_t{0};
+                while (!this->_write_failed && done != part.size()) {
+                    const auto put = raw_write(this->_out, part.data() + done, part.size() - done);
+                    this->_write_failed = put <= 0;
+                    done += put > 0 ? size_t(put) : 0;
+                }
+            }
+        }
+
+        auto failed() -> bool {
+            auto lock = std::lock_guard<std::mutex>(this->_write_mutex);
+            return this->_write_failed;
+        }
+    };
+
+    /**
+     * @brief Parses and solves one request; runs on a pool thread
+     *
+     * Each pool thread keeps its own workspace, so the buffers of a solve are
+     * reused by the next request that lands on the same thread.
+     */
+    auto handle_request(const std::string &payload, const ServerOptions &options) -> std::string {
+        thread_local auto workspace = digraphx::SolveWorkspace{};
+
+        const auto eol = std::min(payload.find('\n'), payload.size());
+        auto header = std::istringstream(payload.substr(0, eol));
+        auto tag = std::string{"?"};
+        auto problem = std::string{"-"};
+        auto format = std::string{"-"};
+        header >> tag >> problem >> format;
+        try {
+            auto report = Report{};
+            report.name = tag;
+            report.options = options.defaults;
+            if (problem != "-") {
+                report.options.problem = digraphx::parse_problem(problem);
+            }
+            const auto fmt = format == "-" ? options.format : digraphx::parse_graph_format(format);
+            const auto start = std::chrono::steady_clock::now();
+            auto body = std::istringstream(eol == payload.size() ? std::string{}
+                                                                 : payload.substr(eol + 1));
+            const auto gra = digraphx::read_graph(body, fmt);
+            if (gra.num_nodes > options.max_nodes) {
+                throw std::runtime_error("graph of " + std::to_string(gra.num_nodes)
+                                         + " nodes exceeds the limit of "
+                                         + std::to_string(options.max_nodes));
+            }
+            report.load_ms = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+            report.num_nodes = gra.num_nodes;
+            report.num_edges = gra.num_edges();
+            report.node_base = fmt == digraphx::GraphFormat::Dimacs ? 1 : 0;
+            report.result = digraphx::solve(gra, report.options, workspace);
+            return format_report(report, options.style);
+        } catch (const std::exception &err) {
+            return format_error(tag, err.what(), options.style);
+        }
+    }
+
+    /**
+     * @brief Serves one input stream until its end
+     *
+     * At most `max_pending` requests are read ahead of their responses, which
+     * bounds the memory held by a fast client.
+     */
+    auto serve(FrameChannel &channel, ThreadPool &pool, const ServerOptions &options) -> int {
+        const auto max_pending = static_cast<std::ptrdiff_t>(
+            options.max_pending != 0 ? options.max_pending : 4 * options.threads);
+        auto slots = std::counting_semaphore<>(max_pending);
+        auto status = 0;
+
+        // Ordered mode: a writer thread emits the responses in request order.
+        auto queue = std::deque<std::future<std::string>>{};
+        auto queue_mutex = std::mutex{};
+        auto queue_ready = std::condition_variable{};
+        auto reading = true;
+        auto writer = std::thread{};
+        if (!options.tagged) {
+            writer = std::thread([&] {
+                while (true) {
+                    auto lock = std::unique_lock<std::mutex>(queue_mutex);
+                    queue_ready.wait(lock, [&] { return !queue.empty() || !reading; });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    auto next = std::move(queue.front());
+                    queue.pop_front();
+                    lock.unlock();
+                    channel.write(next.get());
+                    slots.release();
+                }
+            });
+        }
+
+        try {
+            auto payload = std::string{};
+            while (true) {
+                slots.acquire();
+                if (!channel.read(payload)) {
+                    slots.release();
+                    break;
+                }
+                if (options.tagged) {
+                    pool.enqueue([&channel, &slots, &options, request = std::move(payload)] {
+                        channel.write(handle_request(request, options));
+                        slots.release();
+                    });
+                } else {
+                    auto result = pool.enqueue(handle_request, std::move(payload), options);
+                    auto lock = std::lock_guard<std::mutex>(queue_mutex);
+                    queue.push_back(std::move(result));
+                    queue_ready.notify_one();
+                }
+            }
+        } catch (const std::exception &err) {
+            std::cerr << "server: " << err.what() << std::endl;
+            slots.release();  // the slot taken for the failed read
+            status = 1;
+        }
+
+        if (options.tagged) {
+            for (auto i = std::ptrdiff_t{0}; i != max_pending; ++i) {
+                slots.acquire();  // wait for the requests in flight
+            }
+        } else {
+            {
+                auto lock = std::lock_guard<std::mutex>(queue_mutex);
+                reading = false;
+            }
+            queue_ready.notify_one();
+            writer.join();
+        }
+        return channel.failed() ? 1 : status;
+    }
+
+}  // namespace
+
+auto serve_stdio(const ServerOptions &options) -> int {
+#ifdef _WIN32
+    ::_setmode(0, _O_BINARY);
+    ::_setmode(1, _O_BINARY);
+#endif
+    auto pool = ThreadPool(options.threads);
+    auto channel = FrameChannel(0, 1, options.max_frame);
+    return serve(channel, pool, options);
+}
+
+auto serve_unix_socket(const std::string &path, const ServerOptions &options) -> int {
+#ifdef _WIN32
+    (void)options;
+    std::cerr << "server: Unix domain sockets are not supported on this platform: " << path
+              << std::endl;
+    return 1;
+#else
+    auto addr = sockaddr_un{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "server: socket path too long: " << path << std::endl;
+        return 1;
+    }
+    path.copy(addr.sun_path, path.size());
+
+    // only a stale socket is replaced; any other file at `path` is left alone
+    struct stat info {};
+    if (::lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            std::cerr << "server: not a socket: " << path << std::endl;
+            return 1;
+        }
+        ::unlink(path.c_str());
+    }
+
+    const auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0
+        || ::listen(listener, 16) != 0) {
+        std::perror("server");
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);  // a vanished client must not kill the server
+
+    auto pool = ThreadPool(options.threads);
+    while (true) {
+        const auto conn = ::accept(listener, nullptr, nullptr);
+        if (conn < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::perror("server");
+            ::close(listener);
+            return 1;
+        }
+        auto channel = FrameChannel(conn, conn, options.max_frame);
+        serve(channel, pool, options);
+        ::close(conn);
+    }
+#endif
+}
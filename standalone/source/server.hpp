@@ -0,0 +1,50 @@
+#pragma once
+
+#include <digraphx/solver.hpp>  // for SolveOptions
+#include <string>
+
+#include "report.hpp"  // for OutputFormat
+
+/**
+ * @brief Settings of the batch server
+ *
+ * Requests and responses are frames made of a 4-byte little-endian payload
+ * length followed by the payload. A request payload starts with a header line
+ *
+ *     <tag> <problem> <format>\n
+ *
+ * (e.g. `job17 ratio edgelist`) followed by the graph in that format; `-` for
+ * the problem or format selects the server default. The response payload is
+ * the report of the solve, named after the tag, or an error report for a
+ * malformed request or a graph of more than `max_nodes` nodes. Responses are written in
+ * request order unless `tagged` is set, in which case each one is written as
+ * soon as it is ready and the tag identifies its request.
+ */
+struct ServerOptions {
+    size_t threads{1};
+    size_t max_pending{0};  ///< requests in flight before reading blocks, 0 for 4 per thread
+    size_t max_frame{size_t(64) << 20U};  ///< largest request payload; a longer one ends the input
+    size_t max_nodes{size_t(1) << 24U};   ///< largest graph of a request; a larger one is an error
+    bool tagged{false};
+    OutputFormat style{OutputFormat::Json};
+    digraphx::SolveOptions defaults{};
+    digraphx::GraphFormat format{digraphx::GraphFormat::EdgeList};
+};
+
+/**
+ * @brief Serves requests from the standard input until it is closed
+ *
+ * @return 0 on a clean end of input, 1 on a truncated or oversized frame or I/O error
+ */
+auto serve_stdio(const ServerOptions &options) -> int;
+
+/**
+ * @brief Serves requests from clients of a Unix domain socket, one connection at a time
+ *
+ * The socket file is created at `path`, replacing a stale socket but no
+ * other kind of file, and the function only returns on error. A connection that sends a frame above
+ * `max_frame` bytes is closed.
+ *
+ * @return 1 on error
+ */
+auto serve_unix_socket(const std::string &path, const ServerOptions &options) -> int;
@@ -0,0 +1,83 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/any_graph.hpp>
+#include <digraphx/min_cycle_ratio.hpp>  // for CycleRatioAPI, MinCycleRatioSolver
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>  // for pair
+#include <vector>
+
+using std::list;
+using std::map;
+using std::pair;
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace {
+    using EdgeAttr = map<string, double>;
+    using DictGraph = unordered_map<string, list<pair<string, EdgeAttr>>>;
+
+    auto dict_graph() -> DictGraph {
+        auto edge = [](double cost, double time) {
+            return EdgeAttr{{"cost", cost}, {"time", time}};
+        };
+        return DictGraph{{"a", {{"b", edge(5, 1)}, {"c", edge(1, 1)}}},
+                         {"b", {{"a", edge(1, 1)}, {"c", edge(1, 1)}}},
+                         {"c", {{"b", edge(1, 1)}, {"a", edge(1, 2)}}}};
+    }
+}  // namespace
+
+TEST_CASE("Test AnyGraph numbering") {
+    const auto gra = dict_graph();
+    const auto any = AnyGraph<string, EdgeAttr>(gra);
+    CHECK_EQ(any.num_nodes(), 3);
+    CHECK_EQ(any.num_edges(), 6);
+    for (const auto &[utx, neighbors] : any.csr()) {
+        for (const auto &[vtx, edge] : neighbors) {
+            const auto &targets = gra.at(any.node(utx));
+            auto found = false;
+            for (const auto &[name, attr] : targets) {
+                found = found || (name == any.node(vtx) && attr == any.edge(edge));
+            }
+            CHECK(found);
+        }
+    }
+}
+
+TEST_CASE("Test max_parametric on AnyGraph") {
+    const auto gra = dict_graph();
+    const auto any = AnyGraph<string, EdgeAttr>(gra);
+    auto omega = AnyParametricAPI<EdgeAttr, double>(CycleRatioAPI<DictGraph, double>(gra));
+
+    auto dist = vector<double>(any.num_nodes(), 0.0);
+    auto r_any = 100.0;
+    const auto cycle = max_parametric(any, r_any, omega, dist);
+    CHECK(!cycle.empty());
+
+    // the statically typed solvers agree
+    auto get_cost = [](const EdgeAttr &edge) -> double { return edge.at("cost"); };
+    auto get_time = [](const EdgeAttr &edge) -> double { return edge.at("time"); };
+    auto dist_map = unordered_map<string, double>{{"a", 0.0}, {"b", 0.0}, {"c", 0.0}};
+    auto r_static = 100.0;
+    min_cycle_ratio(gra, r_static, get_cost, get_time, dist_map, 0.0);
+    CHECK_EQ(r_any, doctest::Approx(r_static));
+
+    auto r_solver = 100.0;
+    dist_map = {{"a", 0.0}, {"b", 0.0}, {"c", 0.0}};
+    auto solver = MinCycleRatioSolver<DictGraph, double>(gra);
+    CHECK(!solver.run(r_solver, dist_map, 0.0).empty());
+    CHECK_EQ(r_solver, doctest::Approx(r_static));
+}
+
+TEST_CASE("Test AnyGraph from a dense graph") {
+    const auto gra = CsrGraph(3, vector<uint32_t>{0, 1, 2}, vector<uint32_t>{1, 2, 0});
+    const auto any = AnyGraph<uint32_t, uint32_t>(gra);
+    CHECK_EQ(any.num_nodes(), 3);
+    CHECK_EQ(any.node(2), 2);
+    CHECK_EQ(any.edge(1), 1);
+}
@@ -0,0 +1,133 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/arbitrage.hpp>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef DIGRAPHX_TEST_DATA_DIR
+#    define DIGRAPHX_TEST_DATA_DIR "data"
+#endif
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    /** Replays a tick file through a detector, one batch per time stamp. */
+    auto replay(const vector<RateTick> &ticks, ArbitrageDetector &detector)
+        -> vector<ArbitrageReport> {
+        auto reports = vector<ArbitrageReport>{};
+        auto batch = vector<RateQuote>{};
+        for (size_t i = 0; i != ticks.size(); ++i) {
+            batch.push_back(ticks[i].quote);
+            if (i + 1 == ticks.size() || ticks[i + 1].time != ticks[i].time) {
+                reports.push_back(detector.tick(batch));
+                batch.clear();
+            }
+        }
+        return reports;
+    }
+
+    const vector<uint32_t> from{0, 1, 0, 2, 1, 2, 0, 3, 1, 3};
+    const vector<uint32_t> to{1, 0, 2, 0, 2, 1, 3, 0, 3, 1};
+}  // namespace
+
+TEST_CASE("Test arbitrage detection from a tick file") {
+    auto file = std::ifstream(DIGRAPHX_TEST_DATA_DIR "/ticks.txt");
+    REQUIRE(file.good());
+    const auto ticks = read_rate_ticks(file);
+    REQUIRE_EQ(ticks.size(), 16);
+
+    auto detector = ArbitrageDetector(4, from, to);
+    const auto reports = replay(ticks, detector);
+    REQUIRE_EQ(reports.size(), 5);
+    CHECK(reports[0].cycles.empty());
+    CHECK(reports[0].converged);
+    CHECK(reports[1].cycles.empty());
+    CHECK(reports[1].converged);
+    REQUIRE_EQ(reports[2].cycles.size(), 1);
+    const auto &arb = reports[2].cycles[0];
+    CHECK_EQ(arb.profit, doctest::Approx(0.901 * 0.90 * 1.24 - 1.0));
+    CHECK_EQ(arb.currencies.size(), 3);
+    CHECK(reports[3].cycles.empty());
+    CHECK(reports[4].cycles.empty());
+    CHECK(reports[4].converged);
+}
+
+TEST_CASE("Test arbitrage detection within a pass budget") {
+    // a ring of currencies whose only profitable quote is 0 -> n - 1, so the
+    // potentials need about one pass per currency to expose the cycle
+    const auto n = uint32_t{40};
+    auto chain_from = vector<uint32_t>{};
+    auto chain_to = vector<uint32_t>{};
+    auto quotes = vector<RateQuote>{};
+    for (uint32_t i = 0; i != n; ++i) {
+        chain_from.push_back(n - 1 - i);
+        chain_to.push_back((2 * n - 2 - i) % n);
+        quotes.push_back({chain_from.back(), chain_to.back(), i + 1 == n ? 1.5 : 0.99});
+    }
+    auto options = ArbitrageOptions{};
+    options.max_passes = 2;
+    auto detector = ArbitrageDetector(n, chain_from, chain_to, options);
+    auto report = detector.tick(quotes);
+    auto ticks = 1;
+    while (report.cycles.empty() && ticks != 100) {
+        CHECK(!report.converged);
+        CHECK(report.passes <= 2);
+        report = detector.tick({});
+        ++ticks;
+    }
+    REQUIRE(!report.cycles.empty());
+    CHECK(ticks > 1);
+    CHECK_EQ(report.cycles[0].currencies.size(), n);
+}
+
+TEST_CASE("Test arbitrage input errors") {
+    auto detector = ArbitrageDetector(4, from, to);
+    const auto bad = vector<RateQuote>{{2, 3, 1.0}};
+    CHECK_THROWS_AS(detector.update(bad), std::invalid_argument);
+    auto text = std::istringstream("1 0 1 x\n");
+    CHECK_THROWS_AS(read_rate_ticks(text), std::runtime_error);
+}
+
+TEST_CASE("Test arbitrage ticks that cannot close a cycle skip the search") {
+    const auto pair_from = vector<uint32_t>{0, 1, 0, 2};
+    const auto pair_to = vector<uint32_t>{1, 2, 2, 0};
+    auto detector = ArbitrageDetector(3, pair_from, pair_to);
+
+    // no quoted cycle yet
+    auto report = detector.tick(vector<RateQuote>{{0, 1, 2.0}, {1, 2, 3.0}, {0, 2, 5.0}});
+    CHECK(!report.searched);
+    CHECK(report.converged);
+    CHECK(!detector.components().same_component(0, 2));
+
+    // the first quote on 2 -> 0 closes a profitable cycle
+    report = detector.tick(vector<RateQuote>{{2, 0, 0.2}});
+    CHECK(report.searched);
+    REQUIRE_EQ(report.cycles.size(), 1);
+    CHECK_EQ(report.cycles[0].profit, doctest::Approx(2.0 * 3.0 * 0.2 - 1.0));
+    CHECK(detector.components().same_component(0, 2));
+    CHECK_EQ(detector.components().num_components(), 1);
+
+    report = detector.tick(vector<RateQuote>{{2, 0, 0.1}});
+    CHECK(report.searched);
+    CHECK(report.cycles.empty());
+    CHECK(report.converged);
+
+    // worse rates cannot create arbitrage
+    report = detector.tick(vector<RateQuote>{{1, 2, 2.5}, {0, 2, -1.0}});
+    CHECK(!report.searched);
+    CHECK_EQ(report.passes, 0);
+
+    // a better rate within the component must be searched
+    report = detector.tick(vector<RateQuote>{{1, 2, 4.9}});
+    CHECK(report.searched);
+    CHECK(report.cycles.empty());
+    report = detector.tick(vector<RateQuote>{{1, 2, 5.1}});
+    CHECK(report.searched);
+    CHECK_EQ(report.cycles.size(), 1);
+}
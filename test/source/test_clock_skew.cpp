@@ -0,0 +1,83 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/clock_skew.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    // A -> B -> C -> A
+    const vector<uint32_t> from{0, 1, 2};
+    const vector<uint32_t> to{1, 2, 0};
+
+    /** Checks the setup and hold constraints of every pair at `period` with margin `slack`. */
+    auto meets(const ClockSkewScheduler &sched, const vector<double> &max_delay,
+               const vector<double> &min_delay, const ClockSkewResult &result, double period,
+               double slack) -> bool {
+        const auto eps = 1e-6;
+        for (size_t p = 0; p != sched.num_pairs(); ++p) {
+            const auto s_i = result.skew[from[p]];
+            const auto s_j = result.skew[to[p]];
+            if (s_i + max_delay[p] + slack > s_j + period + eps
+                || s_i + min_delay[p] + eps < s_j + slack) {
+                return false;
+            }
+        }
+        return true;
+    }
+}  // namespace
+
+TEST_CASE("Test minimum clock period") {
+    auto max_delay = vector<double>{7.0, 2.0, 4.0};
+    auto min_delay = vector<double>{4.0, 1.0, 1.0};
+    auto sched = ClockSkewScheduler(3, from, to, max_delay, min_delay);
+
+    // the setup ring needs 3 T >= 7 + 2 + 4, every pair alone at most T >= 3
+    auto result = sched.min_period();
+    REQUIRE(result.feasible);
+    CHECK_EQ(result.value, doctest::Approx(13.0 / 3.0));
+    CHECK_EQ(result.critical.size(), 3);
+    CHECK(meets(sched, max_delay, min_delay, result, result.value, 0.0));
+
+    // incremental updates
+    max_delay[2] = 1.0;
+    sched.update_delay(2, max_delay[2], min_delay[2]);
+    result = sched.min_period();
+    CHECK_EQ(result.value, doctest::Approx(10.0 / 3.0));
+    CHECK(meets(sched, max_delay, min_delay, result, result.value, 0.0));
+
+    max_delay[0] = 10.0;
+    sched.update_delay(0, max_delay[0], min_delay[0]);
+    result = sched.min_period();
+    CHECK_EQ(result.value, doctest::Approx(6.0));  // pair A -> B: 10 - 4
+    CHECK(result.critical == vector<uint32_t>{0, 1} || result.critical == vector<uint32_t>{1, 0});
+    CHECK(meets(sched, max_delay, min_delay, result, result.value, 0.0));
+
+    CHECK_THROWS_AS(sched.update_delay(3, 1.0, 1.0), std::out_of_range);
+}
+
+TEST_CASE("Test maximum slack") {
+    const auto max_delay = vector<double>{7.0, 2.0, 4.0};
+    const auto min_delay = vector<double>{4.0, 1.0, 1.0};
+    auto sched = ClockSkewScheduler(3, from, to, max_delay, min_delay);
+
+    // pairs A -> B and C -> A allow (6 - 7 + 4) / 2 = (6 - 4 + 1) / 2 = 1.5
+    const auto result = sched.max_slack(6.0);
+    CHECK_EQ(result.value, doctest::Approx(1.5));
+    CHECK(meets(sched, max_delay, min_delay, result, 6.0, result.value));
+}
+
+TEST_CASE("Test conflicting hold constraints") {
+    const auto max_delay = vector<double>{7.0, 2.0, 4.0};
+    const auto min_delay = vector<double>{4.0, 1.0, 1.0};
+    auto options = ClockSkewOptions{};
+    options.hold_time = 3.0;  // the hold ring now sums to 6 - 9 < 0
+    auto sched = ClockSkewScheduler(3, from, to, max_delay, min_delay, options);
+    const auto result = sched.min_period();
+    CHECK(!result.feasible);
+    CHECK(result.critical == vector<uint32_t>{1, 3, 5});
+}
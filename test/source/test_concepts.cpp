@@ -0,0 +1,108 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/concepts.hpp>
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/dense_map.hpp>
+#include <digraphx/dynamic_csr.hpp>
+#include <digraphx/map_adapter.hpp>
+#include <digraphx/neg_cycle.hpp>  // for NegCycleFinder
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+using std::list;
+using std::pair;
+using std::unordered_map;
+using std::vector;
+
+using ListGraph = list<pair<size_t, list<pair<size_t, double>>>>;
+using DictGraph = unordered_map<uint32_t, list<pair<uint32_t, uint32_t>>>;
+using VecGraph = MapConstAdapter<vector<list<pair<size_t, double>>>>;
+
+static_assert(DiGraphLike<ListGraph>);
+static_assert(DiGraphLike<DictGraph>);
+static_assert(DiGraphLike<VecGraph>);
+static_assert(DiGraphLike<CsrGraph>);
+static_assert(!DiGraphLike<vector<int>>);
+
+static_assert(!DenseNodeGraph<ListGraph>);
+static_assert(!DenseNodeGraph<DictGraph>);
+static_assert(DenseNodeGraph<VecGraph>);
+static_assert(DenseNodeGraph<CsrGraph>);
+static_assert(DenseNodeGraph<DynamicCsrGraph>);
+
+static_assert(!ContiguousAdjacency<VecGraph>);
+static_assert(ContiguousAdjacency<CsrGraph>);
+static_assert(!ContiguousAdjacency<DynamicCsrGraph>);
+static_assert(SlackAdjacency<DynamicCsrGraph>);
+static_assert(!SlackAdjacency<CsrGraph>);
+
+static_assert(MappingLike<vector<double>, size_t>);
+static_assert(MappingLike<unordered_map<uint32_t, double>, uint32_t>);
+static_assert(ContiguousMapping<vector<double>>);
+static_assert(!ContiguousMapping<unordered_map<uint32_t, double>>);
+
+static_assert(std::is_same_v<graph_node_t<DictGraph>, uint32_t>);
+static_assert(std::is_same_v<graph_edge_t<DictGraph>, uint32_t>);
+static_assert(std::is_same_v<graph_edge_t<CsrGraph>, CsrGraph::edge_type>);
+
+TEST_CASE("Test DenseMap") {
+    auto map = DenseMap<uint32_t, int>(2);
+    CHECK(!map.contains(0));
+    CHECK(!map.contains(5));
+    map[5] = 7;
+    CHECK(map.contains(5));
+    CHECK_EQ(map.at(5), 7);
+    CHECK_THROWS(map.at(1));
+    map.clear();
+    CHECK(!map.contains(5));
+}
+
+TEST_CASE("Test Negative Cycle (MapAdapter fast path)") {
+    vector<list<pair<size_t, double>>> gra{
+        {{1, 7.0}, {2, 5.0}}, {{0, 0.0}, {2, 3.0}}, {{1, 1.0}, {0, -7.0}, {0, 1.0}}};
+    auto get_weight = [](const auto& edge) -> double { return edge; };
+    auto dist = vector<double>(gra.size(), 0.0);
+    auto ga = MapConstAdapter{gra};
+    NegCycleFinder ncf(ga);
+    auto cycle = vector<double>{};
+    for (auto const& ci : ncf.howard(dist, std::move(get_weight))) {
+        cycle = ci;
+        break;
+    }
+    CHECK(!cycle.empty());
+}
+
+TEST_CASE("Test CSR kernel matches the generic kernel") {
+    const vector<uint32_t> source{0, 0, 1, 1, 2, 2, 3, 3};
+    const vector<uint32_t> target{1, 2, 2, 3, 3, 0, 0, 1};
+    const vector<int> weight{4, -1, 2, -3, 5, 1, -2, 3};
+    const auto csr = CsrGraph(4, source, target);
+
+    // the same graph as a hash map keyed by node, edges given by id
+    auto dict = unordered_map<uint32_t, list<pair<uint32_t, uint32_t>>>{};
+    for (uint32_t node = 0; node != 4; ++node) {
+        dict[node];
+    }
+    for (uint32_t edge = 0; edge != source.size(); ++edge) {
+        dict[source[edge]].emplace_back(target[edge], edge);
+    }
+
+    auto get_weight = [&weight](uint32_t edge) -> int { return weight[edge]; };
+    auto dist_csr = vector<int>(4, 0);
+    auto dist_dict = unordered_map<uint32_t, int>{{0, 0}, {1, 0}, {2, 0}, {3, 0}};
+    auto found_csr = false;
+    auto found_dict = false;
+    NegCycleFinder ncf_csr(csr);
+    for (auto const& ci : ncf_csr.howard(dist_csr, get_weight)) {
+        found_csr = !ci.empty();
+    }
+    NegCycleFinder ncf_dict(dict);
+    for (auto const& ci : ncf_dict.howard(dist_dict, get_weight)) {
+        found_dict = !ci.empty();
+    }
+    CHECK(found_csr);
+    CHECK_EQ(found_csr, found_dict);
+}
@@ -0,0 +1,133 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/min_cycle_ratio.hpp>  // for min_cycle_ratio
+#include <digraphx/neg_cycle.hpp>        // for NegCycleFinder
+#include <vector>
+
+using std::vector;
+
+TEST_CASE("Test CsrGraph layout") {
+    const vector<uint32_t> source{2, 0, 1, 0, 2};
+    const vector<uint32_t> target{0, 1, 2, 2, 1};
+    const auto gra = CsrGraph(3, source, target);
+
+    CHECK_EQ(gra.num_nodes(), 3);
+    CHECK_EQ(gra.num_edges(), 5);
+    CHECK_EQ(gra.neighbors(0).size(), 2);
+    CHECK_EQ(gra.neighbors(1).size(), 1);
+    CHECK_EQ(gra.neighbors(2).size(), 2);
+
+    auto count = size_t{0};
+    for (const auto &[utx, neighbors] : gra) {
+        for (const auto &[vtx, edge] : neighbors) {
+            CHECK_EQ(source[edge], utx);
+            CHECK_EQ(target[edge], vtx);
+            ++count;
+        }
+    }
+    CHECK_EQ(count, 5);
+}
+
+TEST_CASE("Test CsrGraph rejects bad node ids") {
+    const vector<uint32_t> source{0, 3};
+    const vector<uint32_t> target{1, 0};
+    CHECK_THROWS(CsrGraph(3, source, target));
+}
+
+TEST_CASE("Test Negative Cycle (CsrGraph)") {
+    const vector<uint32_t> source{0, 0, 1, 1, 2, 2, 2};
+    const vector<uint32_t> target{1, 2, 0, 2, 1, 0, 0};
+    const vector<double> edge_weight{7.0, 5.0, 0.0, 3.0, 1.0, 2.0, -6.0};
+    const auto gra = CsrGraph(3, source, target);
+    auto get_weight = [&edge_weight](uint32_t edge) -> double { return edge_weight[edge]; };
+
+    auto dist = vector<double>(gra.size(), 0.0);
+    NegCycleFinder ncf(gra);
+    auto cycle = vector<uint32_t>{};
+    for (auto const &ci : ncf.howard(dist, get_weight)) {
+        cycle = ci;
+        break;
+    }
+    CHECK(!cycle.empty());
+    auto total = 0.0;
+    for (auto edge : cycle) {
+        total += edge_weight[edge];
+    }
+    CHECK(total < 0.0);
+}
+
+TEST_CASE("Test howard skips a zero-weight policy cycle closed by rounding") {
+    // From these warm-start distances the first pass closes the policy cycle 0 -> 1 -> 2 -> 0,
+    // whose weights sum to zero, with every edge tight after rounding; 3 -> 4 -> 3 is negative.
+    const vector<uint32_t> source{0, 1, 2, 3, 4};
+    const vector<uint32_t> target{1, 2, 0, 4, 3};
+    const vector<double> edge_weight{0.8, -0.3, -0.5, -1.0, 0.5};
+    const auto gra = CsrGraph(5, source, target);
+    auto get_weight = [&edge_weight](uint32_t edge) -> double { return edge_weight[edge]; };
+
+    auto dist = vector<double>{31.5, 99.2, 54.4, 0.0, 0.0};
+    NegCycleFinder ncf(gra);
+    auto count = 0;
+    for (auto const &cycle : ncf.howard(dist, get_weight)) {
+        auto total = 0.0;
+        for (auto edge : cycle) {
+            total += edge_weight[edge];
+        }
+        CHECK_EQ(total, -0.5);
+        ++count;
+    }
+    CHECK_EQ(count, 1);
+}
+
+TEST_CASE("Test minimum cost-to-time ratio (CsrGraph)") {
+    const vector<uint32_t> source{0, 0, 1, 1, 2, 2};
+    const vector<uint32_t> target{1, 2, 0, 2, 1, 0};
+    const vector<int> edge_cost{5, 1, 1, 1, 1, 1};
+    const auto gra = CsrGraph(3, source, target);
+
+    auto get_cost = [&edge_cost](uint32_t edge) -> int { return edge_cost[edge]; };
+    auto get_time = [](uint32_t /* edge */) -> int { return 1; };
+
+    auto dist = vector<int>(gra.size(), 0);
+    auto r = 100.0;
+    const auto cycle = min_cycle_ratio(gra, r, get_cost, get_time, dist, 0);
+    CHECK(!cycle.empty());
+    CHECK_EQ(r, 1.0);
+}
+
+template <typename T> auto neg_cycle_total(const CsrGraph &gra, const vector<T> &weight) -> T {
+    auto dist = vector<T>(gra.size(), T(0));
+    NegCycleFinder ncf(gra);
+    auto total = T(0);
+    for (auto const &ci : ncf.howard(dist, EdgeWeights(weight))) {
+        for (auto edge : ci) {
+            total += weight[edge];
+        }
+        break;
+    }
+    return total;
+}
+
+TEST_CASE("Test precompiled instances (EdgeWeights)") {
+    const vector<uint32_t> source{0, 0, 1, 1, 2, 2, 2};
+    const vector<uint32_t> target{1, 2, 0, 2, 1, 0, 0};
+    const auto gra = CsrGraph(3, source, target);
+
+    CHECK(neg_cycle_total(gra, vector<int32_t>{7, 5, 0, 3, 1, 2, -6}) < 0);
+    CHECK(neg_cycle_total(gra, vector<int64_t>{7, 5, 0, 3, 1, 2, -6}) < 0);
+    CHECK(neg_cycle_total(gra, vector<float>{7, 5, 0, 3, 1, 2, -6}) < 0.0F);
+    CHECK(neg_cycle_total(gra, vector<double>{7, 5, 0, 3, 1, 2, -6}) < 0.0);
+    CHECK_EQ(neg_cycle_total(gra, vector<double>{7, 5, 0, 3, 1, 2, 6}), 0.0);
+
+    const vector<double> edge_cost{5, 1, 1, 1, 1, 1, 1};
+    const vector<double> edge_time{1, 1, 1, 1, 1, 1, 1};
+    auto dist = vector<double>(gra.size(), 0.0);
+    auto r = 100.0;
+    const auto cycle
+        = min_cycle_ratio(gra, r, EdgeWeights(edge_cost), EdgeWeights(edge_time), dist, 0.0);
+    CHECK(!cycle.empty());
+    CHECK_EQ(r, 1.0);
+}
@@ -0,0 +1,58 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/difference_constraints.hpp>
+#include <stdexcept>
+#include <vector>
+
+using std::vector;
+
+TEST_CASE("Test feasible difference constraints") {
+    // x1 - x0 <= 3, x2 - x1 <= -2, x0 - x2 <= 1, x2 - x0 <= 4
+    const vector<uint32_t> from{0, 1, 2, 0};
+    const vector<uint32_t> to{1, 2, 0, 2};
+    const vector<int64_t> bound{3, -2, 1, 4};
+
+    auto solver = DifferenceConstraints<int64_t>{};
+    const auto result = solver.solve(3, from, to, bound);
+    REQUIRE(result.feasible);
+    CHECK(result.cycle.empty());
+    REQUIRE_EQ(result.solution.size(), 3);
+    for (size_t i = 0; i != bound.size(); ++i) {
+        CHECK(result.solution[to[i]] - result.solution[from[i]] <= bound[i]);
+    }
+    // the shortest distances from the virtual source
+    CHECK(result.solution == vector<int64_t>{-1, 0, -2});
+}
+
+TEST_CASE("Test infeasible difference constraints") {
+    // x1 - x0 <= 1, x2 - x1 <= 1, x0 - x2 <= -3, x3 - x0 <= 0
+    const vector<uint32_t> from{0, 1, 2, 0};
+    const vector<uint32_t> to{1, 2, 0, 3};
+    const vector<double> bound{1.0, 1.0, -3.0, 0.0};
+
+    const auto result = solve_difference_constraints<double>(4, from, to, bound);
+    REQUIRE(!result.feasible);
+    CHECK(result.solution.empty());
+    REQUIRE_EQ(result.cycle.size(), 3);
+    auto total = 0.0;
+    for (size_t i = 0; i != result.cycle.size(); ++i) {
+        const auto cons = result.cycle[i];
+        const auto next = result.cycle[(i + 1) % result.cycle.size()];
+        CHECK_EQ(to[cons], from[next]);  // traversal order
+        total += bound[cons];
+    }
+    CHECK(total < 0.0);
+}
+
+TEST_CASE("Test difference constraints input checks") {
+    const vector<uint32_t> from{0};
+    const vector<uint32_t> to{5};
+    const vector<float> bound{1.0F};
+    const vector<float> no_bound{};
+    CHECK_THROWS_AS(solve_difference_constraints<float>(2, from, to, bound),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(solve_difference_constraints<float>(6, from, to, no_bound),
+                    std::invalid_argument);
+}
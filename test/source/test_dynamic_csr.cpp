@@ -0,0 +1,129 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/dynamic_csr.hpp>
+#include <digraphx/neg_cycle.hpp>  // for NegCycleFinder
+#include <random>
+#include <stdexcept>
+#include <utility>  // for pair
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+namespace {
+    /** The `(target, edge)` out-edges of every node, in order */
+    template <typename Graph>
+    auto adjacency(const Graph &gra) -> vector<vector<pair<uint32_t, uint32_t>>> {
+        auto result = vector<vector<pair<uint32_t, uint32_t>>>(gra.num_nodes());
+        for (const auto &[utx, neighbors] : gra) {
+            for (const auto &[vtx, edge] : neighbors) {
+                result[utx].emplace_back(vtx, edge);
+            }
+        }
+        return result;
+    }
+
+    /** The first negative cycle `howard` finds, or an empty one */
+    template <typename Graph>
+    auto find_cycle(const Graph &gra, const vector<double> &weight) -> vector<uint32_t> {
+        auto dist = vector<double>(gra.size(), 0.0);
+        auto ncf = NegCycleFinder<Graph>(gra);
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights<double>(weight))) {
+            return cycle;
+        }
+        return {};
+    }
+}  // namespace
+
+TEST_CASE("Test DynamicCsrGraph layout") {
+    const vector<uint32_t> source{2, 0, 1, 0, 2};
+    const vector<uint32_t> target{0, 1, 2, 2, 1};
+    auto gra = DynamicCsrGraph(3, source, target);
+    CHECK_EQ(gra.num_nodes(), 3);
+    CHECK_EQ(gra.num_edges(), 5);
+    CHECK(gra.capacity() >= 10);
+    CHECK_EQ(adjacency(gra), adjacency(CsrGraph(3, source, target)));
+
+    const auto edge = gra.add_edge(0, 0);
+    CHECK_EQ(edge, 5);
+    CHECK_EQ(gra.source(edge), 0);
+    CHECK_EQ(gra.target(edge), 0);
+    CHECK_EQ(gra.neighbors(0).size(), 3);
+    gra.remove_edge(1);
+    CHECK(!gra.contains(1));
+    const auto out = vector<pair<uint32_t, uint32_t>>{{2, 3}, {0, 5}};
+    CHECK_EQ(adjacency(gra)[0], out);
+    CHECK_EQ(gra.add_edge(1, 0), 1);  // the freed id is reused
+    CHECK_EQ(gra.edge_bound(), 6);
+
+    CHECK_THROWS_AS(gra.add_edge(0, 3), std::invalid_argument);
+    CHECK_THROWS_AS(gra.remove_edge(7), std::invalid_argument);
+    CHECK_THROWS_AS(DynamicCsrGraph(3, vector<uint32_t>{0, 3}, vector<uint32_t>{1, 0}),
+                    std::invalid_argument);
+    CHECK_EQ(gra.add_node(), 3);
+    gra.add_edge(3, 1);
+    CHECK_EQ(gra.neighbors(3).size(), 1);
+}
+
+TEST_CASE("Test DynamicCsrGraph under random insertions and deletions") {
+    const auto num_nodes = uint32_t{200};
+    auto gen = std::mt19937(7);
+    auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+    auto gra = DynamicCsrGraph(num_nodes, {}, {});
+    auto expected = vector<vector<pair<uint32_t, uint32_t>>>(num_nodes);
+    auto live = vector<uint32_t>{};
+    for (int step = 0; step != 20000; ++step) {
+        // grow to about 3000 edges, then shrink back to a few
+        const auto grow = step < 8000 ? gen() % 4 != 0 : gen() % 4 == 0;
+        if (grow || live.empty()) {
+            const auto utx = node(gen);
+            const auto vtx = node(gen);
+            const auto edge = gra.add_edge(utx, vtx);
+            expected[utx].emplace_back(vtx, edge);
+            live.push_back(edge);
+        } else {
+            const auto idx = gen() % live.size();
+            const auto edge = live[idx];
+            live[idx] = live.back();
+            live.pop_back();
+            auto &out = expected[gra.source(edge)];
+            for (auto it = out.begin(); it != out.end(); ++it) {
+                if (it->second == edge) {
+                    out.erase(it);
+                    break;
+                }
+            }
+            gra.remove_edge(edge);
+        }
+        if (step % 1000 == 999) {
+            REQUIRE_EQ(adjacency(gra), expected);
+            CHECK_EQ(gra.num_edges(), live.size());
+            CHECK(gra.capacity() <= 4 * live.size() + 64);
+        }
+    }
+    CHECK(gra.rebalances() > 0);
+}
+
+TEST_CASE("Test negative cycles on a DynamicCsrGraph") {
+    auto gra = DynamicCsrGraph(4, vector<uint32_t>{0, 1, 2}, vector<uint32_t>{1, 2, 3});
+    auto weight = vector<double>{1.0, -2.0, 1.0};
+    CHECK(find_cycle(gra, weight).empty());
+
+    const auto edge = gra.add_edge(3, 0);
+    weight.resize(gra.edge_bound());
+    weight[edge] = -1.0;
+    const auto cycle = find_cycle(gra, weight);
+    CHECK_EQ(cycle.size(), 4);
+
+    gra.remove_edge(edge);
+    CHECK(find_cycle(gra, weight).empty());
+    weight[gra.add_edge(2, 1)] = 2.5;  // reuses the id of the removed edge
+    CHECK(find_cycle(gra, weight).empty());
+    const auto parallel = gra.add_edge(2, 1);
+    weight.resize(gra.edge_bound());
+    weight[parallel] = 1.0;
+    CHECK_EQ(find_cycle(gra, weight).size(), 2);
+}
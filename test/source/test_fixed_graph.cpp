@@ -0,0 +1,80 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <array>
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/fixed_graph.hpp>
+#include <digraphx/neg_cycle.hpp>  // for NegCycleFinder
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    constexpr auto edge_list = std::array<std::pair<uint32_t, uint32_t>, 7>{
+        {{0, 1}, {0, 2}, {1, 0}, {1, 2}, {2, 1}, {2, 0}, {2, 0}}};
+    constexpr auto gra = FixedDiGraph<3, 7>(edge_list);
+
+    constexpr auto negative = std::array<int, 7>{7, 5, 0, 3, 1, 2, -6};
+    constexpr auto positive = std::array<int, 7>{7, 5, 0, 3, 1, 2, 6};
+
+    constexpr auto cycle_cost(const std::array<int, 7> &weight) -> int {
+        auto dist = std::array<int, 3>{};
+        auto ncf = FixedNegCycleFinder<3, 7>(gra);
+        auto total = 0;
+        for (const auto edge : ncf.howard(dist, weight)) {
+            total += weight[edge];
+        }
+        return total;
+    }
+
+    // The whole check runs at compile time.
+    static_assert(has_negative_cycle(gra, negative));
+    static_assert(!has_negative_cycle(gra, positive));
+    static_assert(cycle_cost(negative) < 0);
+
+    // A feasible system yields potentials satisfying every constraint.
+    constexpr auto feasible() -> bool {
+        auto dist = std::array<int, 3>{};
+        auto ncf = FixedNegCycleFinder<3, 7>(gra);
+        if (!ncf.howard(dist, positive).empty()) {
+            return false;
+        }
+        for (size_t i = 0; i != edge_list.size(); ++i) {
+            const auto [utx, vtx] = edge_list[i];
+            if (dist[vtx] - dist[utx] > positive[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(feasible());
+}  // namespace
+
+TEST_CASE("Test FixedNegCycleFinder matches NegCycleFinder") {
+    auto source = std::vector<uint32_t>{};
+    auto target = std::vector<uint32_t>{};
+    for (const auto &[utx, vtx] : edge_list) {
+        source.push_back(utx);
+        target.push_back(vtx);
+    }
+    const auto csr = CsrGraph(3, source, target);
+    auto get_weight = [](uint32_t edge) -> int { return negative[edge]; };
+    auto dist = std::vector<int>(3, 0);
+    auto ncf = NegCycleFinder<CsrGraph>(csr);
+    auto expected = std::vector<uint32_t>{};
+    for (const auto &ci : ncf.howard(dist, get_weight)) {
+        expected = ci;
+        break;
+    }
+
+    auto fixed_dist = std::array<int, 3>{};
+    auto fixed = FixedNegCycleFinder<3, 7>(gra);
+    const auto cycle = fixed.howard(fixed_dist, negative);
+    CHECK(std::vector<uint32_t>(cycle.begin(), cycle.end()) == expected);
+    CHECK(std::vector<int>(fixed_dist.begin(), fixed_dist.end()) == dist);
+}
+
+TEST_CASE("Test FixedDiGraph rejects bad node ids") {
+    const auto bad = std::array<std::pair<uint32_t, uint32_t>, 1>{{{0, 3}}};
+    CHECK_THROWS_AS((FixedDiGraph<3, 1>(bad)), std::invalid_argument);
+}
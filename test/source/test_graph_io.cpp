@@ -0,0 +1,90 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <digraphx/graph_io.hpp>
+#include <sstream>
+#include <stdexcept>
+
+using namespace digraphx;
+
+TEST_CASE("Test read edge list") {
+    std::istringstream input("# u v cost time\n0 1 5 1\n1 2 -1.5 2\n\n2 0 1 1\n");
+    const auto gra = read_graph(input, GraphFormat::EdgeList);
+    CHECK_EQ(gra.num_nodes, 3);
+    CHECK_EQ(gra.num_edges(), 3);
+    CHECK(gra.has_time());
+    CHECK_EQ(gra.source[1], 1);
+    CHECK_EQ(gra.target[1], 2);
+    CHECK_EQ(gra.cost[1], -1.5);
+    CHECK_EQ(gra.time[1], 2.0);
+}
+
+TEST_CASE("Test read DIMACS") {
+    std::istringstream input("c example\np sp 4 2\na 1 2 3\na 4 1 -2\n");
+    const auto gra = read_graph(input, GraphFormat::Dimacs);
+    CHECK_EQ(gra.num_nodes, 4);
+    CHECK_EQ(gra.num_edges(), 2);
+    CHECK(!gra.has_time());
+    CHECK_EQ(gra.source[1], 3);
+    CHECK_EQ(gra.target[1], 0);
+}
+
+TEST_CASE("Test malformed graphs") {
+    std::istringstream mixed("0 1 5 1\n1 0 2\n");
+    CHECK_THROWS_AS(read_graph(mixed, GraphFormat::EdgeList), std::runtime_error);
+    std::istringstream count("p sp 2 2\na 1 2 3\n");
+    CHECK_THROWS_AS(read_graph(count, GraphFormat::Dimacs), std::runtime_error);
+    std::istringstream range("p sp 2 1\na 1 3 3\n");
+    CHECK_THROWS_AS(read_graph(range, GraphFormat::Dimacs), std::runtime_error);
+    std::istringstream binary("not a graph");
+    CHECK_THROWS_AS(read_graph(binary, GraphFormat::Binary), std::runtime_error);
+
+    // `CsrGraph` numbers the nodes with `uint32_t`, so 2^32 nodes are too many
+    std::istringstream nodes("p sp 4294967296 0\n");
+    CHECK_THROWS_AS(read_graph(nodes, GraphFormat::Dimacs), std::runtime_error);
+    std::istringstream node_id("0 4294967295 1\n");
+    CHECK_THROWS_AS(read_graph(node_id, GraphFormat::EdgeList), std::runtime_error);
+
+    // a header claiming 2^32 - 1 edges, none of which follow, is truncated rather than
+    // allocated for
+    auto empty = GraphData{};
+    empty.num_nodes = 2;
+    std::stringstream header;
+    write_graph(header, empty, GraphFormat::Binary);
+    auto bytes = header.str();
+    bytes.replace(16, 4, "\xff\xff\xff\xff");
+    std::istringstream huge(bytes);
+    CHECK_THROWS_AS(read_graph(huge, GraphFormat::Binary), std::runtime_error);
+    bytes = header.str();
+    bytes.replace(8, 8, std::string("\x00\x00\x00\x00\x01\x00\x00\x00", 8));
+    std::istringstream wide(bytes);
+    CHECK_THROWS_AS(read_graph(wide, GraphFormat::Binary), std::runtime_error);
+}
+
+TEST_CASE("Test graph format round trip") {
+    auto gra = GraphData{};
+    gra.num_nodes = 3;
+    gra.source = {0, 1, 2};
+    gra.target = {1, 2, 0};
+    gra.cost = {1.5, -2.0, 3.0};
+    gra.time = {1.0, 2.0, 1.0};
+
+    for (auto format : {GraphFormat::Dimacs, GraphFormat::EdgeList, GraphFormat::Binary}) {
+        std::stringstream buffer;
+        write_graph(buffer, gra, format);
+        const auto back = read_graph(buffer, format);
+        CHECK_EQ(back.num_nodes, gra.num_nodes);
+        CHECK_EQ(back.source, gra.source);
+        CHECK_EQ(back.target, gra.target);
+        CHECK_EQ(back.cost, gra.cost);
+        CHECK_EQ(back.time, gra.time);
+    }
+}
+
+TEST_CASE("Test graph format names") {
+    CHECK(parse_graph_format("binary") == GraphFormat::Binary);
+    CHECK_THROWS_AS(parse_graph_format("xml"), std::invalid_argument);
+    CHECK(guess_graph_format("road.gr") == GraphFormat::Dimacs);
+    CHECK(guess_graph_format("road.dgx") == GraphFormat::Binary);
+    CHECK(guess_graph_format("road.txt") == GraphFormat::EdgeList);
+}
@@ -0,0 +1,112 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/johnson.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using std::vector;
+
+namespace {
+    /** Bellman-Ford from `source`, as a reference */
+    template <typename T>
+    auto bellman_ford(uint32_t num_nodes, const vector<uint32_t> &from, const vector<uint32_t> &to,
+                      const vector<T> &weight, uint32_t source) -> vector<T> {
+        const auto inf = JohnsonShortestPaths<T>::unreachable;
+        auto dist = vector<T>(num_nodes, inf);
+        dist[source] = T(0);
+        for (uint32_t pass = 0; pass != num_nodes; ++pass) {
+            for (size_t i = 0; i != from.size(); ++i) {
+                if (dist[from[i]] != inf && dist[from[i]] + weight[i] < dist[to[i]]) {
+                    dist[to[i]] = dist[from[i]] + weight[i];
+                }
+            }
+        }
+        return dist;
+    }
+
+    /** A random graph with negative weights but no negative cycle */
+    template <typename T> void check_random_graphs(unsigned seed) {
+        auto gen = std::mt19937(seed);
+        auto pick = [&gen](int lo, int hi) {
+            return std::uniform_int_distribution<int>(lo, hi)(gen);
+        };
+        for (auto trial = 0; trial != 10; ++trial) {
+            const auto n = uint32_t(pick(1, 30));
+            auto height = vector<int>(n);
+            for (auto &h : height) {
+                h = pick(-50, 50);
+            }
+            auto from = vector<uint32_t>{};
+            auto to = vector<uint32_t>{};
+            auto weight = vector<T>{};
+            for (auto i = 0; i != 3 * int(n); ++i) {
+                from.push_back(uint32_t(pick(0, int(n) - 1)));
+                to.push_back(uint32_t(pick(0, int(n) - 1)));
+                weight.push_back(T(pick(0, 20) + height[to.back()] - height[from.back()]));
+            }
+            const auto gra = CsrGraph(n, from, to);
+            const auto johnson = JohnsonShortestPaths<T>(gra, EdgeWeights(weight));
+            REQUIRE(johnson.feasible());
+            const auto all = johnson.all_pairs(3);
+            for (uint32_t src = 0; src != n; ++src) {
+                const auto expected = bellman_ford(n, from, to, weight, src);
+                for (uint32_t vtx = 0; vtx != n; ++vtx) {
+                    CHECK_EQ(all[src * n + vtx], expected[vtx]);
+                }
+            }
+        }
+    }
+}  // namespace
+
+TEST_CASE("Test radix heap pops in key order") {
+    auto heap = RadixHeap{};
+    heap.push(5, 0);
+    heap.push(1, 1);
+    heap.push(9, 2);
+    CHECK_EQ(heap.pop().first, 1);
+    heap.push(3, 3);
+    CHECK_EQ(heap.pop().second, 3);
+    CHECK_EQ(heap.pop().first, 5);
+    CHECK_EQ(heap.pop().first, 9);
+    CHECK(heap.empty());
+}
+
+TEST_CASE("Test Johnson shortest paths against Bellman-Ford") {
+    check_random_graphs<int64_t>(1);
+    check_random_graphs<int32_t>(2);
+    check_random_graphs<double>(3);
+}
+
+TEST_CASE("Test Johnson shortest paths from a known potential") {
+    const vector<uint32_t> from{0, 1, 2};
+    const vector<uint32_t> to{1, 2, 0};
+    const vector<int64_t> weight{-2, 3, 1};
+    const auto gra = CsrGraph(3, from, to);
+
+    const vector<int64_t> potential{0, -2, 0};
+    const auto johnson = JohnsonShortestPaths<int64_t>(gra, EdgeWeights(weight), potential);
+    const vector<uint32_t> sources{1};
+    const auto dist = johnson.distances(sources);
+    CHECK_EQ(dist[0], 4);
+    CHECK_EQ(dist[1], 0);
+    CHECK_EQ(dist[2], 3);
+
+    const vector<int64_t> bad{0, 0, 0};
+    CHECK_THROWS_AS(JohnsonShortestPaths<int64_t>(gra, EdgeWeights(weight), bad),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test Johnson shortest paths report a negative cycle") {
+    const vector<uint32_t> from{0, 1, 1};
+    const vector<uint32_t> to{1, 0, 2};
+    const vector<double> weight{1.0, -2.0, 4.0};
+    const auto gra = CsrGraph(3, from, to);
+    const auto johnson = JohnsonShortestPaths<double>(gra, EdgeWeights(weight));
+    CHECK(!johnson.feasible());
+    CHECK_EQ(johnson.cycle().size(), 2);
+    CHECK_THROWS_AS(johnson.all_pairs(), std::invalid_argument);
+}
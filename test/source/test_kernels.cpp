@@ -0,0 +1,121 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/kernels.hpp>
+#include <digraphx/min_cycle_ratio.hpp>  // for min_cycle_ratio
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    struct RandomGraph {
+        CsrGraph csr;
+        vector<double> cost;
+        vector<double> time;
+    };
+
+    auto random_graph(uint32_t num_nodes, size_t num_edges) -> RandomGraph {
+        auto rng = std::mt19937{42};
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        auto value = std::uniform_real_distribution<double>(1.0, 10.0);
+        auto source = vector<uint32_t>{};
+        auto target = vector<uint32_t>{};
+        auto gra = RandomGraph{};
+        for (size_t i = 0; i != num_edges; ++i) {
+            source.push_back(node(rng));
+            target.push_back(node(rng));
+            gra.cost.push_back(value(rng));
+            gra.time.push_back(value(rng));
+        }
+        gra.csr.assign(num_nodes, source, target);
+        return gra;
+    }
+
+    /** Every level this machine can run, lowest first. */
+    auto runnable_isas() -> vector<Isa> {
+        auto isas = vector<Isa>{};
+        for (const auto isa : {Isa::Generic, Isa::Avx2, Isa::Avx512}) {
+            if (select_isa(isa) == isa) {
+                isas.push_back(isa);
+            }
+        }
+        return isas;
+    }
+}  // namespace
+
+TEST_CASE("Test instruction set selection") {
+    for (const auto isa : {Isa::Generic, Isa::Avx2, Isa::Avx512}) {
+        CHECK_EQ(parse_isa(to_string(isa)), isa);
+    }
+    CHECK_THROWS_AS(parse_isa("sse9"), std::invalid_argument);
+
+    const auto initial = active_isa();
+    CHECK_EQ(select_isa(Isa::Generic), Isa::Generic);
+    CHECK_EQ(active_isa(), Isa::Generic);
+    CHECK_EQ(select_isa(Isa::Avx512), detected_isa());  // capped at the detected level
+    select_isa(initial);
+}
+
+TEST_CASE("Test kernel variants agree") {
+    const auto gra = random_graph(200, 1000);
+    const auto initial = active_isa();
+
+    auto ref_weight = vector<double>{};
+    auto ref_dist = vector<double>{};
+    auto ref_ratio = 0.0;
+    auto ref_cycle = vector<uint32_t>{};
+    for (const auto isa : runnable_isas()) {
+        select_isa(isa);
+        auto weight = vector<double>(gra.cost.size());
+        parametric_weights(gra.cost, gra.time, 0.5, weight);
+
+        auto dist = vector<double>(gra.csr.size(), 0.0);
+        auto pred = vector<std::pair<uint32_t, uint32_t>>(gra.csr.size());
+        auto has_pred = vector<uint8_t>(gra.csr.size(), 0);
+        CHECK(relax_csr(gra.csr.offsets(), gra.csr.targets(), gra.csr.edge_ids(),
+                        std::span<const double>(weight), std::span<double>(dist), pred,
+                        has_pred));
+
+        auto ratio = 100.0;
+        auto dist2 = vector<double>(gra.csr.size(), 0.0);
+        const auto cycle = min_cycle_ratio(gra.csr, ratio, EdgeWeights(gra.cost),
+                                           EdgeWeights(gra.time), dist2, 0.0);
+        const auto [total_cost, total_time] = cycle_sums(cycle, gra.cost, gra.time);
+        CHECK_EQ(total_cost / total_time, ratio);
+
+        if (isa == Isa::Generic) {
+            ref_weight = weight;
+            ref_dist = dist;
+            ref_ratio = ratio;
+            ref_cycle = cycle;
+        }
+        CHECK(weight == ref_weight);
+        CHECK(dist == ref_dist);
+        CHECK_EQ(ratio, ref_ratio);
+        CHECK(cycle == ref_cycle);
+    }
+    select_isa(initial);
+}
+
+TEST_CASE("Test min_cycle_ratio kernel path matches the generic path") {
+    const auto gra = random_graph(100, 400);
+    auto get_cost = [&gra](uint32_t edge) -> double { return gra.cost[edge]; };
+    auto get_time = [&gra](uint32_t edge) -> double { return gra.time[edge]; };
+
+    auto r_generic = 100.0;
+    auto dist = vector<double>(gra.csr.size(), 0.0);
+    const auto c_generic = min_cycle_ratio(gra.csr, r_generic, get_cost, get_time, dist, 0.0);
+
+    auto r_kernel = 100.0;
+    dist.assign(gra.csr.size(), 0.0);
+    const auto c_kernel = min_cycle_ratio(gra.csr, r_kernel, EdgeWeights(gra.cost),
+                                          EdgeWeights(gra.time), dist, 0.0);
+    CHECK(!c_kernel.empty());
+    CHECK_EQ(r_kernel, r_generic);
+    CHECK(c_kernel == c_generic);
+}
@@ -0,0 +1,107 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/min_cost_flow.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    /** Checks the capacities and the flow conservation of a feasible result. */
+    void check_flow(const MinCostFlowResult &result, const vector<uint32_t> &from,
+                    const vector<uint32_t> &to, const vector<int64_t> &capacity,
+                    const vector<int64_t> &supply) {
+        auto balance = supply;
+        for (size_t i = 0; i != from.size(); ++i) {
+            CHECK(result.flow[i] >= 0);
+            CHECK(result.flow[i] <= capacity[i]);
+            balance[from[i]] -= result.flow[i];
+            balance[to[i]] += result.flow[i];
+        }
+        for (const auto rest : balance) {
+            CHECK_EQ(rest, 0);
+        }
+    }
+}  // namespace
+
+TEST_CASE("Test min cost flow on a small network") {
+    const vector<uint32_t> from{0, 0, 1, 1, 2};
+    const vector<uint32_t> to{1, 2, 2, 3, 3};
+    const vector<int64_t> capacity{4, 2, 2, 3, 5};
+    const vector<int64_t> cost{2, 2, 1, 3, 1};
+    const vector<int64_t> supply{4, 0, 0, -4};
+
+    auto mcf = MinCostFlow(4, from, to, capacity, cost);
+    const auto result = mcf.solve(supply);
+    CHECK(result.feasible);
+    CHECK_EQ(result.cost, 14);
+    check_flow(result, from, to, capacity, supply);
+
+    const auto baseline = min_cost_flow_cost_scaling(4, from, to, capacity, cost, supply);
+    CHECK(baseline.feasible);
+    CHECK_EQ(baseline.cost, 14);
+    check_flow(baseline, from, to, capacity, supply);
+
+    // solving again warm starts from the potentials of the first solve
+    const vector<int64_t> less{2, 0, 0, -2};
+    CHECK_EQ(mcf.solve(less).cost, 6);
+}
+
+TEST_CASE("Test min cost flow agrees with the cost-scaling baseline") {
+    auto gen = std::mt19937(7);
+    auto pick = [&gen](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(gen); };
+    for (auto trial = 0; trial != 20; ++trial) {
+        const auto n = uint32_t(pick(2, 12));
+        auto from = vector<uint32_t>{};
+        auto to = vector<uint32_t>{};
+        auto capacity = vector<int64_t>{};
+        auto cost = vector<int64_t>{};
+        for (auto i = 0; i != 4 * int(n); ++i) {
+            from.push_back(uint32_t(pick(0, int(n) - 1)));
+            to.push_back(uint32_t(pick(0, int(n) - 1)));
+            capacity.push_back(pick(0, 10));
+            cost.push_back(pick(-5, 20));  // negative cycles are canceled too
+        }
+        auto supply = vector<int64_t>(n, 0);
+        for (auto i = 0; i != 3; ++i) {
+            const auto amount = pick(0, 8);
+            supply[size_t(pick(0, int(n) - 1))] += amount;
+            supply[size_t(pick(0, int(n) - 1))] -= amount;
+        }
+
+        auto mcf = MinCostFlow(n, from, to, capacity, cost);
+        const auto result = mcf.solve(supply);
+        const auto baseline = min_cost_flow_cost_scaling(n, from, to, capacity, cost, supply);
+        CHECK_EQ(result.feasible, baseline.feasible);
+        CHECK_EQ(result.cost, baseline.cost);
+        if (result.feasible) {
+            check_flow(result, from, to, capacity, supply);
+            check_flow(baseline, from, to, capacity, supply);
+        }
+    }
+}
+
+TEST_CASE("Test min cost flow input errors and infeasible supplies") {
+    const vector<uint32_t> from{0};
+    const vector<uint32_t> to{1};
+    const vector<int64_t> capacity{3};
+    const vector<int64_t> cost{1};
+
+    auto mcf = MinCostFlow(2, from, to, capacity, cost);
+    const auto result = mcf.solve(vector<int64_t>{5, -5});
+    CHECK(!result.feasible);
+    CHECK_EQ(result.flow[0], 3);
+
+    CHECK_THROWS_AS(mcf.solve(vector<int64_t>{1, 0}), std::invalid_argument);
+    CHECK_THROWS_AS(mcf.solve(vector<int64_t>{1, -1, 0}), std::invalid_argument);
+    const auto again = mcf.solve(vector<int64_t>{2, -2});  // a rejected supply changes nothing
+    CHECK(again.feasible);
+    CHECK_EQ(again.flow[0], 2);
+    CHECK_EQ(again.cost, 2);
+    const vector<int64_t> negative{-1};
+    CHECK_THROWS_AS(MinCostFlow(2, from, to, negative, cost), std::invalid_argument);
+}
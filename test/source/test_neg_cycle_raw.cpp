@@ -77,3 +77,84 @@ TEST_CASE("Test Negative Cycle (MapAdapter of list's)") {
     }
     CHECK(cycle.empty());
 }
+
+TEST_CASE("Test Negative Cycle (admissible graph search)") {
+    // 0 -> 1 -> 2 -> 0 weighs -1; the policy graph closes it one pass later
+    list<pair<size_t, list<pair<size_t, double>>>> gra{
+        {0, {{1, 0.0}}}, {1, {{2, 0.0}, {0, 4.0}}}, {2, {{0, -1.0}}}};
+    auto get_weight = [](const auto& edge) -> double { return edge; };
+
+    for (const auto search : {CycleSearch::Policy, CycleSearch::Admissible}) {
+        NegCycleFinder ncf(gra);
+        ncf.set_cycle_search(search);
+        auto dist = vector<double>(gra.size(), 0.0);
+        auto cycle = vector<double>{};
+        for (auto const& ci : ncf.howard(dist, get_weight)) {
+            cycle = ci;
+            break;
+        }
+        REQUIRE(cycle.size() == 3);
+        CHECK_EQ(cycle[0] + cycle[1] + cycle[2], -1.0);
+        CHECK_EQ(ncf.passes(), search == CycleSearch::Admissible ? 1 : 2);
+    }
+
+    // no negative cycle: the zero cycle 0 -> 1 -> 0 is admissible but not reported
+    list<pair<size_t, list<pair<size_t, double>>>> flat{
+        {0, {{1, 1.0}, {2, 5.0}}}, {1, {{0, -1.0}, {2, 3.0}}}, {2, {{1, 1.0}, {0, 2.0}}}};
+    NegCycleFinder ncf(flat);
+    ncf.set_cycle_search(CycleSearch::Admissible, 2);
+    auto dist = vector<double>(flat.size(), 0.0);
+    auto found = false;
+    for ([[maybe_unused]] auto const& ci : ncf.howard(dist, get_weight)) {
+        found = true;
+    }
+    CHECK(!found);
+}
+
+TEST_CASE("Test Negative Cycle (admissible search misses a cycle through a finished node)") {
+    // After the first pass all edges are admissible. The search goes 0 -> 1 -> 2 -> 3 -> 0,
+    // a cycle of weight 0, and then skips 0 -> 2 since 2 is finished, so only the policy
+    // graph shows the cycle 0 -> 2 -> 3 -> 0 of weight -1.
+    list<pair<size_t, list<pair<size_t, double>>>> gra{
+        {0, {{1, 0.0}, {2, -1.0}}}, {1, {{2, 0.0}}}, {2, {{3, 0.0}}}, {3, {{0, 0.0}}}};
+    auto get_weight = [](const auto& edge) -> double { return edge; };
+
+    NegCycleFinder ncf(gra);
+    ncf.set_cycle_search(CycleSearch::Admissible);
+    auto dist = vector<double>{0.0, -1.0, 0.0, 0.0};
+    auto cycles = vector<vector<double>>{};
+    for (auto const& ci : ncf.howard(dist, get_weight)) {
+        cycles.push_back(ci);
+    }
+    REQUIRE(cycles.size() == 1);
+    REQUIRE(cycles[0].size() == 3);
+    CHECK_EQ(cycles[0][0] + cycles[0][1] + cycles[0][2], -1.0);
+    CHECK_EQ(ncf.passes(), 1);
+}
+
+TEST_CASE("Test Negative Cycle (admissible search takes fewer passes)") {
+    // a ring i -> i - 1 lowers one more node per pass, so the policy graph closes only after
+    // the last node is reached, while all edges are admissible after the first pass
+    constexpr size_t num_nodes = 16;
+    list<pair<size_t, list<pair<size_t, double>>>> ring{};
+    for (size_t vtx = 0; vtx != num_nodes; ++vtx) {
+        ring.push_back({vtx, {{(vtx + num_nodes - 1) % num_nodes, vtx == 0 ? -1.0 : 0.0}}});
+    }
+    auto get_weight = [](const auto& edge) -> double { return edge; };
+
+    auto passes = vector<size_t>{};
+    for (const auto search : {CycleSearch::Policy, CycleSearch::Admissible}) {
+        NegCycleFinder ncf(ring);
+        ncf.set_cycle_search(search);
+        auto dist = vector<double>(num_nodes, 0.0);
+        auto found = false;
+        for ([[maybe_unused]] auto const& ci : ncf.howard(dist, get_weight)) {
+            found = true;
+            break;
+        }
+        CHECK(found);
+        passes.push_back(ncf.passes());
+    }
+    CHECK_EQ(passes[0], num_nodes - 1);
+    CHECK_EQ(passes[1], 1);
+}
@@ -0,0 +1,329 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/neg_cycle.hpp>
+#include <digraphx/relaxer.hpp>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    /** A random graph with a hub node that has an edge from every other node */
+    struct HubGraph {
+        vector<uint32_t> from{};
+        vector<uint32_t> to{};
+        vector<int64_t> weight{};
+    };
+
+    auto make_hub_graph(uint32_t n, bool negative_cycle) -> HubGraph {
+        auto gen = std::mt19937(5);
+        auto node = std::uniform_int_distribution<uint32_t>(0, n - 1);
+        auto height = vector<int64_t>(n);
+        for (auto &h : height) {
+            h = int64_t(node(gen));
+        }
+        auto gra = HubGraph{};
+        auto add_edge = [&](uint32_t utx, uint32_t vtx, int64_t slack) {
+            gra.from.push_back(utx);
+            gra.to.push_back(vtx);
+            gra.weight.push_back(slack + height[vtx] - height[utx]);
+        };
+        for (uint32_t utx = 1; utx != n; ++utx) {
+            add_edge(utx, 0, int64_t(node(gen) % 7));
+            add_edge(utx, node(gen), int64_t(node(gen) % 7));
+            add_edge(utx - 1, utx, int64_t(node(gen) % 7));
+        }
+        if (negative_cycle) {
+            add_edge(n - 1, n / 2, -int64_t(n) * 7);
+        }
+        return gra;
+    }
+}  // namespace
+
+TEST_CASE("Test push-pull relaxation gives the distances of sweeps") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto threads : {size_t{1}, size_t{4}}) {
+        auto dist = vector<int64_t>(n, 0);
+        auto ncf = NegCycleFinder<CsrGraph>(gra);
+        ncf.set_relax_options({RelaxMode::PushPull, threads, 0.05});
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+            CHECK(cycle.empty());
+        }
+        CHECK(dist == expected);
+        CHECK(ncf.relaxer().push_passes() > 0);
+        if (threads > 1) {
+            CHECK(ncf.relaxer().pull_passes() > 0);
+        }
+    }
+}
+
+TEST_CASE("Test concurrent finders sharing one graph and its transpose") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+    const auto transpose = CsrTranspose(gra);
+    CHECK(transpose.fits(gra));
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    auto dists = vector<vector<int64_t>>(4, vector<int64_t>(n, 0));
+    auto pulls = vector<size_t>(dists.size(), 0);
+    auto pool = vector<std::thread>{};
+    for (size_t idx = 0; idx != dists.size(); ++idx) {
+        pool.emplace_back([&, idx]() {
+            auto ncf = NegCycleFinder<CsrGraph>(gra);
+            ncf.set_relax_options(
+                {.mode = RelaxMode::PushPull, .threads = 2, .transpose = &transpose});
+            for (const auto &cycle : ncf.howard(dists[idx], EdgeWeights(hub.weight))) {
+                CHECK(cycle.empty());
+            }
+            pulls[idx] = ncf.relaxer().pull_passes();
+        });
+    }
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    for (size_t idx = 0; idx != dists.size(); ++idx) {
+        CHECK(dists[idx] == expected);
+        CHECK(pulls[idx] > 0);
+    }
+}
+
+TEST_CASE("Test blocked relaxation gives the distances of sweeps") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto block_size : {size_t{0}, size_t{64}, size_t{1}}) {
+        auto dist = vector<int64_t>(n, 0);
+        auto ncf = NegCycleFinder<CsrGraph>(gra);
+        auto options = RelaxOptions{};
+        options.mode = RelaxMode::Blocked;
+        options.block_size = block_size;
+        options.local_passes = 4;
+        ncf.set_relax_options(options);
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+            CHECK(cycle.empty());
+        }
+        CHECK(dist == expected);
+        CHECK(ncf.relaxer().local_passes() >= ncf.relaxer().blocked_passes());
+    }
+
+    auto options = RelaxOptions{};
+    options.mode = RelaxMode::Blocked;
+    options.local_passes = 0;
+    CHECK_THROWS_AS(CsrRelaxer{options}, std::invalid_argument);
+    auto ncf = NegCycleFinder<CsrGraph>(gra);
+    CHECK_THROWS_AS(ncf.set_relax_options(options), std::invalid_argument);
+}
+
+TEST_CASE("Test async relaxation gives the distances of sweeps") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto threads : {size_t{1}, size_t{4}}) {
+        for (const auto epoch_edges : {1.0, 0.01}) {
+            auto dist = vector<int64_t>(n, 0);
+            auto ncf = NegCycleFinder<CsrGraph>(gra);
+            auto options = RelaxOptions{};
+            options.mode = RelaxMode::Async;
+            options.threads = threads;
+            options.epoch_edges = epoch_edges;
+            ncf.set_relax_options(options);
+            for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+                CHECK(cycle.empty());
+            }
+            CHECK(dist == expected);
+            CHECK(ncf.relaxer().async_epochs() > 0);
+        }
+    }
+}
+
+TEST_CASE("Test delta-stepping gives the distances of sweeps") {
+    const auto n = uint32_t{10000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto threads : {size_t{1}, size_t{4}}) {
+        for (const auto delta : {0.0, 1.0, 1e6}) {
+            auto dist = vector<int64_t>(n, 0);
+            auto ncf = NegCycleFinder<CsrGraph>(gra);
+            auto options = RelaxOptions{};
+            options.mode = RelaxMode::Delta;
+            options.threads = threads;
+            options.delta = delta;
+            options.epoch_edges = 0.5;
+            ncf.set_relax_options(options);
+            for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+                CHECK(cycle.empty());
+            }
+            CHECK(dist == expected);
+            CHECK(ncf.relaxer().delta() >= 1.0);
+            CHECK(ncf.relaxer().bucket_phases() > 0);
+        }
+    }
+}
+
+TEST_CASE("Test Pape-Levit and threshold relaxation give the distances of sweeps") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto mode : {RelaxMode::Deque, RelaxMode::Threshold}) {
+        for (const auto epoch_edges : {1.0, 0.01}) {
+            auto dist = vector<int64_t>(n, 0);
+            auto ncf = NegCycleFinder<CsrGraph>(gra);
+            auto options = RelaxOptions{};
+            options.mode = mode;
+            options.epoch_edges = epoch_edges;
+            ncf.set_relax_options(options);
+            for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+                CHECK(cycle.empty());
+            }
+            CHECK(dist == expected);
+            CHECK(ncf.relaxer().scans() >= n);
+        }
+    }
+}
+
+TEST_CASE("Test adaptive relaxation switches between sweeps, pushes and pulls") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto expected = vector<int64_t>(n, 0);
+    auto sweep = NegCycleFinder<CsrGraph>(gra);
+    for (const auto &cycle : sweep.howard(expected, EdgeWeights(hub.weight))) {
+        CHECK(cycle.empty());
+    }
+
+    for (const auto threads : {size_t{1}, size_t{4}}) {
+        auto dist = vector<int64_t>(n, 0);
+        auto ncf = NegCycleFinder<CsrGraph>(gra);
+        auto options = RelaxOptions{};
+        options.mode = RelaxMode::Adaptive;
+        options.threads = threads;
+        ncf.set_relax_options(options);
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+            CHECK(cycle.empty());
+        }
+        CHECK(dist == expected);
+        CHECK(ncf.relaxer().push_passes() > 0);
+        CHECK(ncf.relaxer().sweep_passes() > 0);
+        if (threads > 1) {
+            CHECK(ncf.relaxer().pull_passes() > 0);
+        }
+    }
+}
+
+TEST_CASE("Test adaptive relaxation sweeps the early passes on several threads") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, false);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto options = RelaxOptions{};
+    options.mode = RelaxMode::Adaptive;
+    options.threads = 4;
+    auto relaxer = CsrRelaxer(options);
+    auto dist = vector<int64_t>(n, 0);
+    auto pred = vector<std::pair<uint32_t, uint32_t>>(n);
+    auto has_pred = vector<uint8_t>(n, 0);
+    relaxer.restart();
+    relaxer.relax<int64_t>(gra, hub.weight, dist, pred, has_pred);
+    CHECK_EQ(relaxer.sweep_passes(), 1);
+    CHECK_EQ(relaxer.pull_passes(), 0);
+    CHECK_EQ(relaxer.push_passes(), 0);
+}
+
+TEST_CASE("Test the relaxation modes find negative cycles") {
+    const auto n = uint32_t{2000};
+    const auto hub = make_hub_graph(n, true);
+    const auto gra = CsrGraph(n, hub.from, hub.to);
+
+    auto blocked = RelaxOptions{};
+    blocked.mode = RelaxMode::Blocked;
+    blocked.block_size = 256;
+    auto async = RelaxOptions{};
+    async.mode = RelaxMode::Async;
+    async.threads = 4;
+    auto delta = async;
+    delta.mode = RelaxMode::Delta;
+    auto deque = RelaxOptions{};
+    deque.mode = RelaxMode::Deque;
+    auto threshold = RelaxOptions{};
+    threshold.mode = RelaxMode::Threshold;
+    auto adaptive = RelaxOptions{};
+    adaptive.mode = RelaxMode::Adaptive;
+    for (const auto &options : {RelaxOptions{RelaxMode::PushPull, 4, 0.05}, blocked, async, delta,
+                                deque, threshold, adaptive}) {
+        auto dist = vector<int64_t>(n, 0);
+        auto ncf = NegCycleFinder<CsrGraph>(gra);
+        ncf.set_relax_options(options);
+        auto found = false;
+        for (const auto &cycle : ncf.howard(dist, EdgeWeights(hub.weight))) {
+            auto total = int64_t{0};
+            for (const auto edge : cycle) {
+                total += hub.weight[edge];
+            }
+            CHECK(total < 0);
+            found = true;
+        }
+        CHECK(found);
+    }
+}
+
+TEST_CASE("Test relaxation mode names") {
+    CHECK(parse_relax_mode("pushpull") == RelaxMode::PushPull);
+    CHECK(parse_relax_mode("blocked") == RelaxMode::Blocked);
+    CHECK_EQ(to_string(RelaxMode::Async), "async");
+    CHECK(parse_relax_mode("delta") == RelaxMode::Delta);
+    CHECK(parse_relax_mode("deque") == RelaxMode::Deque);
+    CHECK_EQ(to_string(RelaxMode::Threshold), "threshold");
+    CHECK(parse_relax_mode("adaptive") == RelaxMode::Adaptive);
+    CHECK_EQ(to_string(RelaxMode::Sweep), "sweep");
+    CHECK_THROWS_AS(parse_relax_mode("gather"), std::invalid_argument);
+}
@@ -0,0 +1,41 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <cstdint>  // for uint32_t, int64_t
+#include <digraphx/retiming.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+TEST_CASE("Test retiming of the Leiserson-Saxe correlator") {
+    // host, four comparators and three adders
+    const vector<double> delay{0, 3, 3, 3, 3, 7, 7, 7};
+    const vector<uint32_t> from{0, 1, 2, 3, 1, 2, 3, 4, 5, 6, 7};
+    const vector<uint32_t> to{1, 2, 3, 4, 7, 6, 5, 5, 6, 7, 0};
+    const vector<uint32_t> registers{1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+
+    auto retiming = Retiming(delay, from, to, registers);
+    const auto result = retiming.min_period();
+    CHECK_EQ(result.period, 13.0);
+    CHECK(result.cycle_bound <= result.period);
+
+    for (size_t i = 0; i != registers.size(); ++i) {
+        CHECK(result.registers[i] >= 0);
+        CHECK_EQ(result.registers[i],
+                 registers[i] + result.retiming[to[i]] - result.retiming[from[i]]);
+    }
+
+    auto lag = vector<int64_t>{};
+    CHECK(retiming.feasible(12.0, lag) < 0.0);
+    CHECK(retiming.feasible(24.0, lag) <= 24.0);
+}
+
+TEST_CASE("Test retiming rejects combinational cycles") {
+    const vector<double> delay{1, 1};
+    const vector<uint32_t> from{0, 1};
+    const vector<uint32_t> to{1, 0};
+    const vector<uint32_t> registers{0, 0};
+    CHECK_THROWS_AS(Retiming(delay, from, to, registers), std::invalid_argument);
+}
@@ -0,0 +1,200 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <algorithm>  // for min, shuffle, swap
+#include <cstdint>    // for uint32_t
+#include <digraphx/csr_graph.hpp>
+#include <digraphx/relaxer.hpp>
+#include <digraphx/scc.hpp>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>  // for pair
+#include <vector>
+
+using namespace digraphx;
+using std::vector;
+
+namespace {
+    /**
+     * @brief A random graph of `num_nodes` nodes with many components of various sizes
+     *
+     * Nodes are cut into runs of random length closed into rings, half of them
+     * single nodes, and random edges only go from a run to a later one, so the
+     * rings are the components.
+     * Node ids are shuffled.
+     */
+    auto make_ring_graph(uint32_t num_nodes, uint32_t seed) -> CsrGraph {
+        auto gen = std::mt19937(seed);
+        auto perm = vector<uint32_t>(num_nodes);
+        for (uint32_t vtx = 0; vtx != num_nodes; ++vtx) {
+            perm[vtx] = vtx;
+        }
+        std::shuffle(perm.begin(), perm.end(), gen);
+        auto from = vector<uint32_t>{};
+        auto to = vector<uint32_t>{};
+        auto length = std::uniform_int_distribution<uint32_t>(1, 40);
+        for (uint32_t first = 0; first < num_nodes;) {
+            const auto kind = gen() % 4;
+            const auto size = kind == 0 ? length(gen) * 50 : kind == 1 ? length(gen) : 1;
+            const auto last = std::min(num_nodes, first + size);
+            for (auto vtx = first; vtx + 1 < last; ++vtx) {
+                from.push_back(perm[vtx]);
+                to.push_back(perm[vtx + 1]);
+            }
+            if (last - first > 1) {
+                from.push_back(perm[last - 1]);
+                to.push_back(perm[first]);
+            }
+            first = last;
+        }
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        for (uint32_t i = 0; i != num_nodes * 2; ++i) {
+            auto utx = node(gen);
+            auto vtx = node(gen);
+            if (utx > vtx) {
+                std::swap(utx, vtx);
+            }
+            from.push_back(perm[utx]);
+            to.push_back(perm[vtx]);
+        }
+        return CsrGraph(num_nodes, from, to);
+    }
+}  // namespace
+
+TEST_CASE("Test strongly connected components of a small graph") {
+    // 0 <-> 1 -> 2 -> 3 -> 2, 4 alone with a self loop, 5 -> 0
+    const auto from = vector<uint32_t>{0, 1, 1, 2, 3, 4, 5};
+    const auto to = vector<uint32_t>{1, 0, 2, 3, 2, 4, 0};
+    const auto gra = CsrGraph(6, from, to);
+    for (const auto threads : {size_t{1}, size_t{3}}) {
+        const auto scc = strongly_connected_components(gra, {threads, 0});
+        CHECK_EQ(scc.count, 4);
+        CHECK(scc.component == vector<uint32_t>{0, 0, 1, 1, 2, 3});
+        CHECK(scc.sizes() == vector<uint32_t>{2, 2, 1, 1});
+    }
+
+    const auto dag = condense(gra, strongly_connected_components(gra));
+    CHECK_EQ(dag.dag.num_nodes(), 4);
+    CHECK_EQ(dag.dag.num_edges(), 2);  // {0,1} -> {2,3} and 5 -> {0,1}
+    CHECK(dag.edge == vector<uint32_t>{2, 6});
+    CHECK(cyclic_edges(gra, strongly_connected_components(gra))
+          == vector<uint32_t>{0, 1, 3, 4, 5});
+}
+
+TEST_CASE("Test trimming removes the acyclic nodes") {
+    // a chain 0 -> 1 -> ... -> 9 into the ring 10 -> 11 -> 12 -> 10, and 13 -> 13
+    auto from = vector<uint32_t>{};
+    auto to = vector<uint32_t>{};
+    for (uint32_t vtx = 0; vtx != 10; ++vtx) {
+        from.push_back(vtx);
+        to.push_back(vtx + 1);
+    }
+    for (const auto &[utx, vtx] : {std::pair{11U, 12U}, {12U, 10U}, {10U, 11U}, {13U, 13U}}) {
+        from.push_back(utx);
+        to.push_back(vtx);
+    }
+    const auto gra = CsrGraph(14, from, to);
+    const auto transpose = CsrTranspose(gra);
+    for (const auto threads : {size_t{1}, size_t{4}}) {
+        const auto trimmed = trim_trivial(gra, transpose, threads);
+        for (uint32_t vtx = 0; vtx != 14; ++vtx) {
+            CHECK_EQ(trimmed[vtx], vtx < 10 || vtx == 13 ? 1 : 0);
+        }
+    }
+    CHECK_THROWS_AS(trim_trivial(gra, CsrTranspose{}), std::invalid_argument);
+}
+
+TEST_CASE("Test parallel strongly connected components match Tarjan's") {
+    for (const auto seed : {1U, 2U, 3U}) {
+        const auto gra = make_ring_graph(20000, seed);
+        const auto expected = strongly_connected_components(gra);
+        CHECK_EQ(expected.trimmed, 0);
+        CHECK(expected.count > 20);
+        const auto transpose = CsrTranspose(gra);
+        for (const auto threads : {size_t{2}, size_t{4}}) {
+            for (const auto serial_below : {size_t{0}, size_t{1000}}) {
+                const auto scc
+                    = strongly_connected_components(gra, transpose, {threads, serial_below});
+                CHECK_EQ(scc.count, expected.count);
+                CHECK(scc.component == expected.component);
+                CHECK(scc.trimmed > 0);
+                if (serial_below == 0) {
+                    CHECK(scc.color_rounds > 0);
+                }
+            }
+        }
+
+        // the condensation is acyclic: every component of it is a single node
+        const auto dag = condense(gra, expected);
+        CHECK_EQ(strongly_connected_components(dag.dag).count, expected.count);
+        auto source = vector<uint32_t>(gra.num_edges());
+        for (uint32_t utx = 0; utx != gra.num_nodes(); ++utx) {
+            for (const auto &[vtx, edge] : gra.neighbors(utx)) {
+                source[edge] = utx;
+            }
+        }
+        for (uint32_t comp = 0; comp != dag.dag.num_nodes(); ++comp) {
+            for (const auto &[other, edge] : dag.dag.neighbors(comp)) {
+                CHECK_NE(other, comp);
+                CHECK_EQ(expected.component[source[dag.edge[edge]]], comp);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test incremental components of a small graph") {
+    auto scc = IncrementalScc(5);
+    CHECK_EQ(scc.num_components(), 5);
+    CHECK(!scc.add_edge(0, 1));
+    CHECK(!scc.add_edge(1, 2));
+    CHECK(!scc.add_edge(3, 4));
+    CHECK(scc.position(0) < scc.position(2));
+    CHECK(!scc.add_edge(4, 0));  // backwards in the initial order, but no cycle
+    CHECK(scc.position(4) < scc.position(0));
+    CHECK(scc.add_edge(2, 0));
+    CHECK(scc.same_component(0, 2));
+    CHECK(!scc.same_component(0, 3));
+    CHECK_EQ(scc.component_size(1), 3);
+    CHECK(scc.add_edge(2, 3));
+    CHECK_EQ(scc.num_components(), 1);
+    CHECK_EQ(scc.merges(), 4);
+    CHECK_EQ(scc.components().component, vector<uint32_t>(5, 0));
+    CHECK_THROWS_AS(scc.add_edge(0, 5), std::invalid_argument);
+    CHECK_EQ(scc.add_node(), 5);
+    CHECK_EQ(scc.num_components(), 2);
+}
+
+TEST_CASE("Test incremental components match a recomputation") {
+    for (const auto seed : {1U, 2U, 3U}) {
+        const auto num_nodes = uint32_t{300};
+        auto gen = std::mt19937(seed);
+        auto node = std::uniform_int_distribution<uint32_t>(0, num_nodes - 1);
+        auto scc = IncrementalScc(num_nodes);
+        auto from = vector<uint32_t>{};
+        auto to = vector<uint32_t>{};
+        for (int batch = 0; batch != 12; ++batch) {
+            const auto first = from.size();
+            for (int i = 0; i != 40; ++i) {
+                from.push_back(node(gen));
+                to.push_back(node(gen));
+            }
+            scc.add_edges(std::span(from).subspan(first), std::span(to).subspan(first));
+
+            const auto expected = strongly_connected_components(CsrGraph(num_nodes, from, to));
+            const auto actual = scc.components();
+            REQUIRE_EQ(actual.count, expected.count);
+            CHECK_EQ(actual.component, expected.component);
+            CHECK_EQ(scc.num_components(), expected.count);
+            for (size_t i = 0; i != from.size(); ++i) {
+                if (scc.same_component(from[i], to[i])) {
+                    CHECK_EQ(scc.position(from[i]), scc.position(to[i]));
+                } else {
+                    CHECK(scc.position(from[i]) < scc.position(to[i]));
+                }
+            }
+        }
+        CHECK(scc.reorders() > 0);
+        CHECK_EQ(scc.merges(), num_nodes - scc.num_components());
+    }
+}
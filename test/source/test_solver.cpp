@@ -0,0 +1,172 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <algorithm>  // for sort
+#include <digraphx/solver.hpp>
+#include <stdexcept>
+#include <utility>  // for pair
+#include <vector>
+
+using namespace digraphx;
+
+namespace {
+    auto example_graph() -> GraphData {
+        auto gra = GraphData{};
+        gra.num_nodes = 3;
+        gra.source = {0, 0, 1, 1, 2, 2};
+        gra.target = {1, 2, 0, 2, 1, 0};
+        gra.cost = {5.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+        gra.time = {1.0, 1.0, 1.0, 1.0, 1.0, 2.0};
+        return gra;
+    }
+}  // namespace
+
+TEST_CASE("Test solve negative cycle") {
+    auto gra = example_graph();
+    auto options = SolveOptions{};
+    CHECK(!solve(gra, options).has_cycle);
+
+    gra.cost[5] = -3.0;  // 0 -> 2 -> 0 now costs -2
+    const auto result = solve(gra, options);
+    REQUIRE(result.has_cycle);
+    CHECK(result.value < 0.0);
+    REQUIRE_EQ(result.cycle_nodes.size(), result.cycle_edges.size());
+    for (size_t i = 0; i != result.cycle_edges.size(); ++i) {
+        const auto edge = result.cycle_edges[i];
+        CHECK_EQ(gra.source[edge], result.cycle_nodes[i]);
+        CHECK_EQ(gra.target[edge], result.cycle_nodes[(i + 1) % result.cycle_nodes.size()]);
+    }
+}
+
+TEST_CASE("Test solve cycle ratio and mean cycle") {
+    const auto gra = example_graph();
+    auto options = SolveOptions{};
+    options.problem = Problem::CycleRatio;
+    const auto ratio = solve(gra, options);
+    REQUIRE(ratio.has_cycle);
+    CHECK_EQ(ratio.value, doctest::Approx(2.0 / 3.0));
+
+    options.problem = Problem::MeanCycle;
+    const auto mean = solve(gra, options);
+    REQUIRE(mean.has_cycle);
+    CHECK_EQ(mean.value, doctest::Approx(1.0));
+}
+
+TEST_CASE("Test solve rejects unusable graphs") {
+    auto gra = example_graph();
+    gra.time.clear();
+    auto options = SolveOptions{};
+    options.problem = Problem::CycleRatio;
+    CHECK_THROWS_AS(solve(gra, options), std::invalid_argument);
+    CHECK_THROWS_AS(parse_problem("flow"), std::invalid_argument);
+    CHECK(parse_engine("howard") == Engine::Howard);
+    CHECK(parse_engine("admissible") == Engine::Admissible);
+}
+
+TEST_CASE("Test solve with relaxation options and admissible search") {
+    const auto gra = example_graph();
+    auto options = SolveOptions{};
+    options.problem = Problem::CycleRatio;
+    options.engine = Engine::Admissible;
+    options.relax.mode = RelaxMode::Deque;
+    const auto ratio = solve(gra, options);
+    REQUIRE(ratio.has_cycle);
+    CHECK_EQ(ratio.value, doctest::Approx(2.0 / 3.0));
+}
+
+TEST_CASE("Test solve with a reused workspace") {
+    auto workspace = SolveWorkspace{};
+    auto options = SolveOptions{};
+    options.problem = Problem::MeanCycle;
+    const auto big = example_graph();
+    const auto first = solve(big, options, workspace);
+
+    auto small = GraphData{};
+    small.num_nodes = 2;
+    small.source = {0, 1};
+    small.target = {1, 0};
+    small.cost = {3.0, -1.0};
+    const auto second = solve(small, options, workspace);
+    REQUIRE(second.has_cycle);
+    CHECK_EQ(second.value, doctest::Approx(1.0));
+    CHECK_EQ(workspace.csr.num_nodes(), 2);
+
+    const auto again = solve(big, options, workspace);
+    CHECK_EQ(again.value, doctest::Approx(first.value));
+    CHECK_EQ(again.cycle_edges, first.cycle_edges);
+}
+
+TEST_CASE("Test solve_all on a shared graph") {
+    auto gra = example_graph();
+    auto negative = gra.cost;
+    negative[5] = -3.0;  // 0 -> 2 -> 0 now costs -2
+    const auto shared = SharedGraph(gra);
+
+    auto queries = std::vector<Query>(4);
+    queries[0].options.problem = Problem::CycleRatio;
+    queries[1].options.problem = Problem::MeanCycle;
+    queries[1].options.relax = RelaxOptions{.mode = RelaxMode::PushPull, .threads = 2};
+    queries[2].cost = negative;
+    queries[3].ratio = 1.0;  // some cycle has a ratio below 1
+
+    for (const size_t threads : {1, 3}) {
+        const auto results = solve_all(shared, queries, threads);
+        REQUIRE_EQ(results.size(), queries.size());
+        CHECK_EQ(results[0].value, doctest::Approx(2.0 / 3.0));
+        CHECK_EQ(results[1].value, doctest::Approx(1.0));
+        REQUIRE(results[2].has_cycle);
+        CHECK_EQ(results[2].value, doctest::Approx(-2.0));
+        REQUIRE(results[3].has_cycle);
+        CHECK(results[3].value < 0.0);
+    }
+
+    auto workspace = SolveWorkspace{};
+    auto query = Query{};
+    query.cost = {1.0};
+    CHECK_THROWS_AS(solve(shared, query, workspace), std::invalid_argument);
+    query.cost.clear();
+    query.ratio = 2.0;
+    auto untimed = gra;
+    untimed.time.clear();
+    CHECK_THROWS_AS(solve_all(SharedGraph(untimed), std::span(&query, 1), 2),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test solve with pruning to the strongly connected components") {
+    auto gra = example_graph();
+    // the cheap edges out of node 3 and into node 4 are on no cycle
+    gra.num_nodes = 5;
+    for (const auto &[utx, vtx] : {std::pair{3U, 0U}, {2U, 4U}}) {
+        gra.source.push_back(utx);
+        gra.target.push_back(vtx);
+        gra.cost.push_back(-10.0);
+        gra.time.push_back(1.0);
+    }
+    auto options = SolveOptions{};
+    options.problem = Problem::CycleRatio;
+    options.prune = true;
+    const auto ratio = solve(gra, options);
+    REQUIRE(ratio.has_cycle);
+    CHECK_EQ(ratio.value, doctest::Approx(2.0 / 3.0));
+    for (const auto edge : ratio.cycle_edges) {
+        CHECK(edge < 6);
+    }
+
+    gra.cost[5] = -3.0;  // 0 -> 2 -> 0 now costs -2
+    options.problem = Problem::NegCycle;
+    const auto negative = solve(gra, options);
+    REQUIRE(negative.has_cycle);
+    CHECK_EQ(negative.value, doctest::Approx(-2.0));
+    auto edges = negative.cycle_edges;
+    std::sort(edges.begin(), edges.end());
+    CHECK(edges == std::vector<uint32_t>{1, 5});
+
+    auto acyclic = GraphData{};
+    acyclic.num_nodes = 2;
+    acyclic.source = {0};
+    acyclic.target = {1};
+    acyclic.cost = {-1.0};
+    CHECK(!solve(acyclic, options).has_cycle);
+    options.problem = Problem::CycleRatio;
+    CHECK_THROWS_AS(solve(acyclic, options), std::invalid_argument);
+}
@@ -0,0 +1,55 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <atomic>
+#include <cstddef>  // for size_t
+#include <digraphx/thread_team.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace digraphx;
+
+TEST_CASE("Test thread team runs every worker and keeps its threads") {
+    auto team = ThreadTeam{};
+    team.run(1, [](size_t idx) { CHECK_EQ(idx, 0); });
+    CHECK_EQ(team.size(), 0);
+
+    for (size_t count = 2; count != 6; ++count) {
+        auto calls = std::vector<int>(count, 0);
+        team.run(count, [&](size_t idx) { ++calls[idx]; });
+        CHECK_EQ(calls, std::vector<int>(count, 1));
+        CHECK_EQ(team.size(), count - 1);
+    }
+    team.run(3, [](size_t) {});
+    CHECK_EQ(team.size(), 4);
+
+    // the workers of a run are concurrent, so they can wait for each other
+    auto arrived = std::atomic<size_t>{0};
+    team.run(4, [&](size_t) {
+        ++arrived;
+        while (arrived.load() != 4) {
+        }
+    });
+    CHECK_EQ(arrived.load(), 4);
+
+    const auto copy = team;
+    CHECK_EQ(copy.size(), 0);
+}
+
+TEST_CASE("Test thread team rethrows after all workers return") {
+    auto team = ThreadTeam{};
+    auto finished = std::atomic<size_t>{0};
+    CHECK_THROWS_AS(team.run(3,
+                             [&](size_t idx) {
+                                 if (idx == 1) {
+                                     throw std::runtime_error("worker failed");
+                                 }
+                                 ++finished;
+                             }),
+                    std::runtime_error);
+    CHECK_EQ(finished.load(), 2);
+
+    auto calls = std::atomic<size_t>{0};
+    team.run(3, [&](size_t) { ++calls; });
+    CHECK_EQ(calls.load(), 3);
+}
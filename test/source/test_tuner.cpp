@@ -0,0 +1,99 @@
+// -*- coding: utf-8 -*-
+#include <doctest/doctest.h>  // for ResultBuilder, TestCase
+
+#include <digraphx/tuner.hpp>
+#include <sstream>
+#include <stdexcept>
+
+using namespace digraphx;
+
+namespace {
+    /** Ring of `num_nodes` nodes with chords, every `negative`-th edge costing -1 */
+    auto ring_graph(uint32_t num_nodes, uint32_t negative) -> GraphData {
+        auto gra = GraphData{};
+        gra.num_nodes = num_nodes;
+        for (uint32_t utx = 0; utx != num_nodes; ++utx) {
+            for (const auto step : {1U, 7U}) {
+                gra.source.push_back(utx);
+                gra.target.push_back((utx + step) % num_nodes);
+                gra.cost.push_back(gra.cost.size() % negative == 0 ? -1.0 : 2.0);
+                gra.time.push_back(1.0);
+            }
+        }
+        return gra;
+    }
+}  // namespace
+
+TEST_CASE("Test profile_graph") {
+    auto gra = ring_graph(100, 4);
+    const auto profile = profile_graph(gra);
+    CHECK_EQ(profile.num_nodes, 100);
+    CHECK_EQ(profile.num_edges, 200);
+    CHECK_EQ(profile.mean_degree, doctest::Approx(2.0));
+    CHECK_EQ(profile.degree_skew, doctest::Approx(1.0));
+    CHECK_EQ(profile.num_sccs, 1);
+    CHECK_EQ(profile.largest_scc, 100);
+    CHECK_EQ(profile.negative_fraction, doctest::Approx(0.25));
+    CHECK_EQ(profile.locality, doctest::Approx(1.0));
+
+    // a path is acyclic: every node is its own component
+    auto path = GraphData{};
+    path.num_nodes = 4;
+    path.source = {0, 1, 2};
+    path.target = {1, 2, 3};
+    path.cost = {1.0, -1.0, 1.0};
+    const auto dag = profile_graph(path);
+    CHECK_EQ(dag.num_sccs, 4);
+    CHECK_EQ(dag.largest_scc, 1);
+    CHECK(AutoTuner::rules(dag, 1).relax.mode == RelaxMode::Sweep);
+
+    CHECK_EQ(graph_family(profile), graph_family(profile_graph(ring_graph(120, 4))));
+    CHECK_NE(graph_family(profile), graph_family(profile_graph(ring_graph(100, 50))));
+}
+
+TEST_CASE("Test AutoTuner rules") {
+    auto profile = GraphProfile{};
+    profile.num_nodes = 1U << 20U;
+    profile.num_edges = 1U << 22U;
+    profile.largest_scc = profile.num_nodes;
+    profile.negative_fraction = 0.5;
+    profile.locality = 0.9;
+    CHECK(AutoTuner::rules(profile, 1).relax.mode == RelaxMode::Blocked);
+    const auto parallel = AutoTuner::rules(profile, 4);
+    CHECK(parallel.relax.mode == RelaxMode::Adaptive);
+    CHECK_EQ(parallel.relax.threads, 4);
+    profile.negative_fraction = 0.01;
+    CHECK(AutoTuner::rules(profile, 4).relax.mode == RelaxMode::Deque);
+}
+
+TEST_CASE("Test AutoTuner trials, cache and table") {
+    const auto gra = ring_graph(200, 3);
+    auto tuner = AutoTuner(TunerOptions{.trials = true, .max_threads = 2, .trial_passes = 8});
+    const auto choice = tuner.choose(gra, Problem::CycleRatio);
+    CHECK(choice.trial_ms >= 0.0);
+    CHECK_EQ(tuner.size(), 1);
+    CHECK(tuner.choose(ring_graph(210, 3), Problem::CycleRatio).relax.mode == choice.relax.mode);
+    CHECK_EQ(tuner.size(), 1);
+
+    auto options = SolveOptions{};
+    options.problem = Problem::CycleRatio;
+    const auto tuned = tuner.tune(gra, options);
+    CHECK(tuned.engine == choice.engine);
+    CHECK(tuned.relax.mode == choice.relax.mode);
+    CHECK_EQ(solve(gra, tuned).value, doctest::Approx(solve(gra, options).value));
+
+    auto table = std::stringstream{};
+    tuner.write_table(table);
+    auto loaded = AutoTuner{};
+    loaded.read_table(table);
+    CHECK_EQ(loaded.size(), 1);
+    const auto cached = loaded.choose(gra, Problem::CycleRatio);
+    CHECK(cached.engine == choice.engine);
+    CHECK(cached.relax.mode == choice.relax.mode);
+    CHECK_EQ(cached.relax.threads, choice.relax.threads);
+
+    auto bad = std::istringstream("n8-d1 ratio howard sweep\n");
+    CHECK_THROWS_AS(loaded.read_table(bad), std::runtime_error);
+    auto unknown = std::istringstream("n8-d1 ratio howard warp 1\n");
+    CHECK_THROWS_AS(loaded.read_table(unknown), std::runtime_error);
+}
@@ -29,6 +29,12 @@ target("test_digraphx")
     add_files("test/source/*.cpp")
     add_packages("doctest", "fmt")
 
+target("bench_digraphx")
+    set_kind("binary")
+    add_deps("DiGraphX")
+    add_files("bench/BM_*.cpp")
+    add_packages("benchmark", "fmt")
+
 -- target("test_ell")
 --     set_kind("binary")
 --     add_deps("EcGen")